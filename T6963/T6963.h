@@ -67,18 +67,30 @@
 
 extern "C"{
 	#include <inttypes.h>
+#if defined(__AVR__)
 	#include <avr/io.h>
 	#include <avr/pgmspace.h>
 	#include <util/delay.h>
+#endif
 }
 
+#if !defined(__AVR__)
+	#include "T6963_Host.h"
+#endif
+
 #include "T6963_Commands.h"
+#include "T6963_Bus.h"
 
 
 //*************************************************************************************************
 //	Global Definitions
 //*************************************************************************************************
 
+//Geometry of the default panel (the T6963 class and the LCD object), a sketch declares any
+//other panel as T6963Panel<width, height, font width, memory, bus>, eg
+//
+//	T6963Panel<128, 64, 8, 4> small;
+
 #define SCREEN_WIDTH	240
 #define SCREEN_HEIGHT	128
 
@@ -88,16 +100,27 @@ extern "C"{
 #define SCREEN_COLS			(SCREEN_WIDTH/FONT_WIDTH)
 #define SCREEN_ROWS			(SCREEN_HEIGHT/FONT_HEIGHT)
 
+//Controller ram in kilobytes
 #define MEM_SIZE	8
 
 #define MEM_TEXT_START		0
-#define MEM_TEXT_WIDTH		SCREEN_COLS
+#define MEM_TEXT_WIDTH		((SCREEN_WIDTH+FONT_WIDTH-1)/FONT_WIDTH)
 #define MEM_TEXT_HEIGHT		SCREEN_ROWS
 #define MEM_TEXT_AREA		(MEM_TEXT_WIDTH*MEM_TEXT_HEIGHT)
 #define MEM_TEXT_END		(MEM_TEXT_START+MEM_TEXT_AREA)
 
-#define MEM_GRAPH_START		MEM_TEXT_END
-#define MEM_GRAPH_WIDTH		(SCREEN_WIDTH/FONT_WIDTH)
+//Keep a second copy of the text area after it so the console scrolls by moving the text home address
+//(240x128 needs MEM_SIZE of 16 or more)
+//#define GLCD_CONSOLE
+
+#ifdef GLCD_CONSOLE
+	#define MEM_TEXT_SIZE	(2*MEM_TEXT_AREA)
+#else
+	#define MEM_TEXT_SIZE	MEM_TEXT_AREA
+#endif
+
+#define MEM_GRAPH_START		(MEM_TEXT_START+MEM_TEXT_SIZE)
+#define MEM_GRAPH_WIDTH		((SCREEN_WIDTH+FONT_WIDTH-1)/FONT_WIDTH)
 #define MEM_GRAPH_HEIGHT	SCREEN_HEIGHT
 #define MEM_GRAPH_AREA		(MEM_GRAPH_WIDTH*SCREEN_HEIGHT)
 #define MEM_GRAPH_END		(MEM_GRAPH_START+MEM_GRAPH_AREA)
@@ -106,19 +129,180 @@ extern "C"{
 #define MEM_CG_START		(MEM_CG_OFFSET*256*8)
 #define MEM_CG_SIZE			(256*8)
 
+//Graphic pages fill the ram between the text area and CG ram
+#define MEM_GRAPH_PAGES		((MEM_CG_START-MEM_GRAPH_START)/MEM_GRAPH_AREA)
+#define MEM_GRAPH_PAGE(n)	(MEM_GRAPH_START+(n)*MEM_GRAPH_AREA)
+
+#if MEM_GRAPH_PAGES < 1
+	#error "MEM_SIZE is too small for the text area, a graphic page and CG ram"
+#endif
+
+//Big digits are 3x3 text cells built from this many CG ram glyphs
+#define BIG_DIGIT_WIDTH		3
+#define BIG_DIGIT_HEIGHT	3
+#define BIG_DIGIT_GLYPHS	39
+
+//Keep a copy of the text area in ram (MEM_TEXT_AREA bytes) and only send changed cells
+//#define GLCD_TEXT_SHADOW
+
+//Unchanged cells rewritten to join two runs of changed cells instead of a new address set
+#define GLCD_TEXT_GAP		4
+
+//Draw into a copy of the graphic area in ram (MEM_GRAPH_AREA bytes) and send it with flush()
+//#define GLCD_FRAMEBUFFER
+
+//Unchanged bytes rewritten to join two dirty ranges in flush() instead of a new address set
+#define GLCD_FRAME_GAP		4
+
+//Only check the status before the first argument byte of a command, the other arguments follow
+//without it (the command byte itself is always checked). The datasheet asks for the check before
+//every byte, this only works on a controller that takes an argument faster than the driver sends
+//the next one, and the host emulator counts each skipped check in its errors
+//#define GLCD_SKIP_STATUS
+
+//Copy drawing calls into a display list in ram between record() and endRecord()
+//#define GLCD_RECORD
+
+//Queue command and data bytes in ram and send them from service(), called from a timer
+//interrupt or the idle loop, so drawing returns without waiting on the controller
+//#define GLCD_QUEUE
+
+//Queue entries (a power of two up to 256) and the most that one call of service() sends
+#define GLCD_QUEUE_SIZE		64
+#define GLCD_QUEUE_BURST	16
+
+
+
+//*************************************************************************************************
+//	Display Lists
+//*************************************************************************************************
+
+//A display list is an opcode byte per call followed by its arguments, bytes (b) as they are
+//and words (w) low byte first, ending with GLCD_OP_END. record() builds one in ram, or one can
+//be written into program memory at build time with the GLCD_LIST macros:
+//
+//	const uint8_t screen[] PROGMEM = {
+//		GLCD_LIST_MOVE_TO(10, 20), GLCD_LIST_RECT(60, 24),
+//		GLCD_LIST_TEXT_TO(3, 3), GLCD_LIST_TEXT, 'O', 'K', 0,
+//		GLCD_LIST_END
+//	};
+//
+//	LCD.playPgm(screen);
+
+#define GLCD_OP_END				0x00
+#define GLCD_OP_COLOR			0x01	//b color
+#define GLCD_OP_CLIP			0x02	//b x, b y, b w, b h
+#define GLCD_OP_CLEAR_CLIP		0x03
+#define GLCD_OP_CLEAR_GRAPH		0x04
+#define GLCD_OP_MOVE			0x05	//w dx, w dy
+#define GLCD_OP_MOVE_TO			0x06	//b x, b y
+#define GLCD_OP_LINE			0x07	//w dx, w dy
+#define GLCD_OP_LINE_TO			0x08	//b x, b y
+#define GLCD_OP_RECT			0x09	//w dx, w dy
+#define GLCD_OP_RECT_DIAG		0x0A	//w dx, w dy, b diag
+#define GLCD_OP_FILL_RECT		0x0B	//w dx, w dy
+#define GLCD_OP_FILL_RECT_DIAG	0x0C	//w dx, w dy, b diag
+#define GLCD_OP_FILL_RECT_TO	0x0D	//b x, b y
+#define GLCD_OP_ELLIPSE			0x0E	//b x radius, b y radius
+#define GLCD_OP_FILL_ELLIPSE	0x0F	//b x radius, b y radius
+#define GLCD_OP_ARC				0x10	//b radius, w start, w end
+#define GLCD_OP_FILL_ARC		0x11	//b radius, w start, w end
+#define GLCD_OP_BEGIN_POLY		0x12
+#define GLCD_OP_VERTEX			0x13	//w x, w y
+#define GLCD_OP_FILL_POLY		0x14
+#define GLCD_OP_CLEAR_TEXT		0x15
+#define GLCD_OP_TEXT_MOVE		0x16	//w col, w row
+#define GLCD_OP_TEXT_TO			0x17	//b col, b row
+#define GLCD_OP_TEXT			0x18	//characters up to and including a 0
+
+#define GLCD_LIST_WORD(w)				((uint8_t)(w)), ((uint8_t)((uint16_t)(w) >> 8))
+
+#define GLCD_LIST_END					GLCD_OP_END
+#define GLCD_LIST_COLOR(c)				GLCD_OP_COLOR, (c)
+#define GLCD_LIST_CLIP(x, y, w, h)		GLCD_OP_CLIP, (x), (y), (w), (h)
+#define GLCD_LIST_CLEAR_CLIP			GLCD_OP_CLEAR_CLIP
+#define GLCD_LIST_CLEAR_GRAPH			GLCD_OP_CLEAR_GRAPH
+#define GLCD_LIST_MOVE(dx, dy)			GLCD_OP_MOVE, GLCD_LIST_WORD(dx), GLCD_LIST_WORD(dy)
+#define GLCD_LIST_MOVE_TO(x, y)			GLCD_OP_MOVE_TO, (x), (y)
+#define GLCD_LIST_LINE(dx, dy)			GLCD_OP_LINE, GLCD_LIST_WORD(dx), GLCD_LIST_WORD(dy)
+#define GLCD_LIST_LINE_TO(x, y)			GLCD_OP_LINE_TO, (x), (y)
+#define GLCD_LIST_RECT(dx, dy)			GLCD_OP_RECT, GLCD_LIST_WORD(dx), GLCD_LIST_WORD(dy)
+#define GLCD_LIST_RECT_DIAG(dx, dy, d)	GLCD_OP_RECT_DIAG, GLCD_LIST_WORD(dx), GLCD_LIST_WORD(dy), (d)
+#define GLCD_LIST_FILL_RECT(dx, dy)		GLCD_OP_FILL_RECT, GLCD_LIST_WORD(dx), GLCD_LIST_WORD(dy)
+#define GLCD_LIST_FILL_RECT_DIAG(dx, dy, d)	GLCD_OP_FILL_RECT_DIAG, GLCD_LIST_WORD(dx), GLCD_LIST_WORD(dy), (d)
+#define GLCD_LIST_FILL_RECT_TO(x, y)	GLCD_OP_FILL_RECT_TO, (x), (y)
+#define GLCD_LIST_CIRCLE(r)				GLCD_OP_ELLIPSE, (r), (r)
+#define GLCD_LIST_ELLIPSE(rx, ry)		GLCD_OP_ELLIPSE, (rx), (ry)
+#define GLCD_LIST_FILL_CIRCLE(r)		GLCD_OP_FILL_ELLIPSE, (r), (r)
+#define GLCD_LIST_FILL_ELLIPSE(rx, ry)	GLCD_OP_FILL_ELLIPSE, (rx), (ry)
+#define GLCD_LIST_ARC(r, s, e)			GLCD_OP_ARC, (r), GLCD_LIST_WORD(s), GLCD_LIST_WORD(e)
+#define GLCD_LIST_FILL_ARC(r, s, e)		GLCD_OP_FILL_ARC, (r), GLCD_LIST_WORD(s), GLCD_LIST_WORD(e)
+#define GLCD_LIST_BEGIN_POLY			GLCD_OP_BEGIN_POLY
+#define GLCD_LIST_VERTEX(x, y)			GLCD_OP_VERTEX, GLCD_LIST_WORD(x), GLCD_LIST_WORD(y)
+#define GLCD_LIST_FILL_POLY				GLCD_OP_FILL_POLY
+#define GLCD_LIST_CLEAR_TEXT			GLCD_OP_CLEAR_TEXT
+#define GLCD_LIST_TEXT_MOVE(dc, dr)		GLCD_OP_TEXT_MOVE, GLCD_LIST_WORD(dc), GLCD_LIST_WORD(dr)
+#define GLCD_LIST_TEXT_TO(col, row)		GLCD_OP_TEXT_TO, (col), (row)
+#define GLCD_LIST_TEXT					GLCD_OP_TEXT
+
 
 
 //*************************************************************************************************
 //	Class Definition
 //*************************************************************************************************
 
-class T6963
+//Graphic column and bit of every pixel x in program memory, for font widths without a shift
+template <uint8_t Font>
+struct T6963Columns
+{
+	static const uint8_t column[256];
+	static const uint8_t bit[256];
+};
+
+template <uint8_t Width, uint8_t Height, uint8_t Font, uint8_t Memory, class Bus = GLCD_BUS>
+class T6963Panel
 {
 	public:
-		T6963();
+		//Geometry and memory map, known at compile time so divisions fold into constants
+		static const int16_t screenWidth = Width;
+		static const int16_t screenHeight = Height;
+		static const int16_t fontWidth = Font;
+		static const int16_t fontHeight = 8;
+		static const int16_t screenCols = Width / Font;
+		static const int16_t screenRows = Height / 8;
+		
+		//The controller shows every column that starts on the screen, so a panel that is not a whole
+		//number of font widths wide keeps a partly shown column in both areas
+		static const int16_t textStart = 0;
+		static const int16_t textWidth = (Width + Font - 1) / Font;
+		static const int16_t textHeight = screenRows;
+		static const int16_t textArea = textWidth * textHeight;
+		static const int16_t textEnd = textStart + textArea;
+#ifdef GLCD_CONSOLE
+		static const int16_t textSize = 2 * textArea;
+#else
+		static const int16_t textSize = textArea;
+#endif
+
+		static const int16_t graphStart = textStart + textSize;
+		static const int16_t graphWidth = (Width + Font - 1) / Font;
+		static const int16_t graphHeight = Height;
+		static const int16_t graphArea = graphWidth * Height;
+		static const int16_t graphEnd = graphStart + graphArea;
+		
+		static const uint8_t cgOffset = Memory / 2 - 1;
+		static const uint16_t cgStart = cgOffset * 256U * 8U;
+		static const int16_t cgSize = 256 * 8;
+		
+		static const uint8_t graphPages = ((int32_t)cgStart - graphStart) / graphArea;
+		
+		T6963Panel();
 		
 		void setMode(uint8_t, uint8_t);
 		void setDisplay(uint8_t);
+		void setShowPage(uint8_t);
+		void setDrawPage(uint8_t);
+		void flipPage(void);
 		
 		void setAddress(void);
 		void setText(void);
@@ -134,7 +318,20 @@ class T6963
 		void writeByteDec(uint8_t);
 		
 		void writeBit(uint8_t);
+		void writeMask(uint8_t, uint8_t);
+		void writeMask(uint8_t, uint8_t, uint8_t);
 		void writeBlock(uint8_t, uint16_t);
+		void readBlock(uint8_t*, uint16_t);
+		void readRow(uint8_t*, uint8_t);
+		void readRow(uint8_t*, uint8_t, uint8_t, uint8_t);
+		
+		void flush(void);
+		
+#ifdef GLCD_QUEUE
+		uint8_t pending(void);
+		void sync(void);
+		void service(void);
+#endif
 		//void writeBlock(uint8_t, uint8_t, uint8_t);
 		
 		void horizLine(int16_t);
@@ -144,6 +341,8 @@ class T6963
 		
 		void clearGraph(void);
 		void setColor(uint8_t);
+		void setClip(uint8_t, uint8_t, uint8_t, uint8_t);
+		void clearClip(void);
 		void move(int16_t, int16_t);
 		void moveTo(uint8_t, uint8_t);
 		void line(int16_t, int16_t);
@@ -151,6 +350,31 @@ class T6963
 		void rect(int16_t, int16_t);
 		void rect(int16_t, int16_t, uint8_t);
 		void rectTo(uint8_t, uint8_t);
+		void fillRect(int16_t, int16_t);
+		void fillRect(int16_t, int16_t, uint8_t);
+		void fillRectTo(uint8_t, uint8_t);
+		
+		void circle(uint8_t);
+		void ellipse(uint8_t, uint8_t);
+		void arc(uint8_t, int16_t, int16_t);
+		void fillCircle(uint8_t);
+		void fillEllipse(uint8_t, uint8_t);
+		void fillArc(uint8_t, int16_t, int16_t);
+		
+		void beginPoly(void);
+		void vertex(int16_t, int16_t);
+		void fillPoly(void);
+		
+#ifdef GLCD_RECORD
+		void record(uint8_t*, uint16_t);
+		uint16_t endRecord(void);
+#endif
+		void play(const uint8_t*);
+		void playPgm(const uint8_t*);
+		
+		void drawBitmapPgm(uint8_t, uint8_t, uint8_t, uint8_t, const uint8_t*);
+		void drawRlePgm(uint8_t, uint8_t, const uint8_t*);
+		void copyRegion(uint8_t, uint8_t, uint8_t, uint8_t, uint8_t, uint8_t);
 		
 		void clearText(void);
 		void clearText(int16_t);
@@ -161,28 +385,170 @@ class T6963
 		void textPgm(prog_char*);
 		void textPgm(prog_char*, int16_t);
 		
+#ifdef GLCD_CONSOLE
+		void clearConsole(void);
+		void console(char*);
+		void consolePgm(prog_char*);
+#endif
+
 		void clearCG(void);
+		void loadGlyphs(uint8_t, uint8_t, const uint8_t*);
+		void loadBigDigits(uint8_t);
+		void bigText(char*);
 		
 		void init(void);
 		
 	private:
 		uint16_t _address;
 		uint16_t _text;
+		uint16_t _pointer;
+		uint16_t _graph;
 		
 		uint8_t _bit;
 		uint8_t _color;
+		uint8_t _bigBase;
+		uint8_t _showPage;
+		uint8_t _drawPage;
+		uint8_t _auto;
+		uint8_t _ready;
+		uint8_t _autoStatus;
 		
-		uint8_t _lastX;
-		uint8_t _lastY;
+#ifdef GLCD_CONSOLE
+		uint8_t _console;
+#endif
+
+#ifdef GLCD_QUEUE
+		volatile uint16_t _queue[GLCD_QUEUE_SIZE];
+		volatile uint8_t _queueHead;
+		volatile uint8_t _queueTail;
+		volatile uint8_t _serving;
+		
+		void queue(uint8_t, uint8_t);
+#endif
+
+#ifdef GLCD_TEXT_SHADOW
+		uint8_t _shadow[textArea];
+#endif
+
+#ifdef GLCD_FRAMEBUFFER
+		uint8_t _frame[graphArea];
+		uint8_t _dirtyLeft[graphHeight];
+		uint8_t _dirtyRight[graphHeight];
+		uint16_t _frameStart;
+		uint8_t _frameRow;
+		uint16_t _device;
+		uint8_t _virtual;
+		
+		uint8_t frameRead(void);
+		void frameWrite(uint8_t);
+#endif
+
+		int16_t _lastX;
+		int16_t _lastY;
 		
-		uint8_t readStatus(void);
+		uint8_t _clipLeft;
+		uint8_t _clipTop;
+		uint8_t _clipRight;
+		uint8_t _clipBottom;
+		
+		//Ends of an arc as directions scaled by 255 (y up), wide when it is more than a half turn
+		struct Sector
+		{
+			int16_t startX;
+			int16_t startY;
+			int16_t endX;
+			int16_t endY;
+			uint8_t wide;
+		};
+		
+		//Polygon edge from its top row down to the row before bottom, x is where it crosses the
+		//current row rounded up, step and rem are its change per row as a whole and a fraction of dy
+		struct Edge
+		{
+			int16_t top;
+			int16_t bottom;
+			int16_t x;
+			int16_t step;
+			int16_t rem;
+			int16_t dy;
+			int16_t error;
+			int16_t next;
+		};
+		
+		Edge *_edges;
+		uint16_t _edgeSize;
+		uint16_t _edgeCount;
+		uint8_t _edgeFull;
+		int16_t _polyX;
+		int16_t _polyY;
+		int16_t _polyFirstX;
+		int16_t _polyFirstY;
+		uint8_t _polyOpen;
+		
+#ifdef GLCD_RECORD
+		uint8_t *_list;
+		uint16_t _listSize;
+		uint16_t _listLength;
+		uint8_t _listFull;
+		
+		uint8_t recordOp(uint8_t, uint16_t);
+		void recordByte(uint8_t);
+		void recordWord(int16_t);
+#endif
+
+		//Fails to compile when the memory map does not fit in the controller ram
+		typedef char memoryFits[graphPages >= 1 && graphPages < 64 ? 1 : -1];
+		
+		static uint8_t shiftColumn(const uint8_t**, uint8_t*, uint16_t*, uint8_t*);
+		static uint8_t bigRow(uint8_t, uint8_t, uint8_t);
+		static uint8_t copyColumn(const uint8_t*, uint8_t, uint8_t, uint8_t);
+		static int16_t intercept(int16_t, int16_t, int16_t, int16_t, int16_t);
+		static void direction(int16_t, int16_t*, int16_t*);
+		static uint8_t makeSector(Sector*, int16_t, int16_t);
+		static void halfPlane(int16_t, int32_t, int16_t*, int16_t*);
+		static uint8_t listByte(const uint8_t**, uint8_t);
+		static int16_t listWord(const uint8_t**, uint8_t);
+		
+		void setPointer(uint16_t);
+		
+		void span(uint8_t, uint8_t, uint8_t);
+		void fill(uint8_t, uint8_t, uint8_t, uint8_t);
+		
+		void setPen(int16_t, int16_t);
+		uint8_t outCode(int16_t, int16_t);
+		void segment(int16_t, int16_t);
+		void clipSpan(int16_t, int16_t, int16_t);
+		void clipFill(int16_t, int16_t, int16_t, int16_t);
+		
+		void curveSpan(int16_t, int16_t, int16_t, const Sector*);
+		void curveRow(int16_t, int16_t, int16_t, uint8_t, const Sector*);
+		void curve(uint8_t, uint8_t, uint8_t, const Sector*);
+		
+		void addEdge(int16_t, int16_t, int16_t, int16_t);
+		
+		void replay(const uint8_t*, uint8_t);
+		
+		void writeText(uint16_t, uint8_t);
+		void writeTextDec(uint16_t, uint8_t);
+		void endText(void);
+		
+		void waitStatus(uint8_t);
 		uint8_t readData(void);
+		uint8_t readAuto(void);
 		
 		void writeCommand(uint8_t);
 		void writeData(uint8_t);
+		void writeAuto(uint8_t);
+		void autoWrite(void);
+		void autoRead(void);
+		void autoReset(void);
 };
 
+typedef T6963Panel<SCREEN_WIDTH, SCREEN_HEIGHT, FONT_WIDTH, MEM_SIZE> T6963;
+
 extern T6963 LCD;
 
+#include "T6963_Panel.h"
+
 #endif
 
@@ -0,0 +1,391 @@
+/*
+	Bus transports for the T6963 library
+
+	Each transport is a class of static inline functions, the driver takes it as a
+	template parameter so every bus cycle compiles down to the port instructions
+
+		init()					set the pin directions and leave the bus idle
+		modeRead()				data lines to input
+		modeWrite()				data lines to output
+		read()					data lines
+		write(data)				set the data lines
+		controlReset()			bus idle (CE, RD, WR, CD high)
+		controlReadStatus()		strobe a status read
+		controlReadData()		strobe a data read
+		controlWriteCommand()	strobe a command write
+		controlWriteData()		strobe a data write
+
+	The ports and pins a transport uses are its template parameters, so a sketch
+	wires its own panel without editing the library:
+
+		typedef T6963BusSplit<T6963PortC, T6963PortD, T6963Pin<T6963PortC, 4>,
+			T6963Pin<T6963PortC, 5>, T6963Pin<T6963PortD, 2> > Bus;
+
+		T6963Panel<240, 128, 6, 8, Bus> lcd;
+
+	The parameters default to the GLCD_* wiring macros below. The LCD object is
+	built in T6963.cpp, which never sees a sketch's defines, so its transport and
+	wiring are chosen by editing this file: uncomment one of the switches below or
+	change the macros. Wiring from a sketch only reaches the panels it declares
+	itself, as above. Only the host transport exists when the library is not built
+	for an AVR
+*/
+
+#ifndef T6963_BUS_H
+#define T6963_BUS_H
+
+//*************************************************************************************************
+//	Bus Selection
+//*************************************************************************************************
+
+//#define GLCD_SPLIT_PORT
+//#define GLCD_SHIFT_REGISTER
+
+#ifndef GLCD_BUS
+	#if !defined(__AVR__)
+		#define GLCD_BUS	T6963BusHost
+	#elif defined(GLCD_SPLIT_PORT)
+		#define GLCD_BUS	T6963BusSplit<>
+	#elif defined(GLCD_SHIFT_REGISTER)
+		#define GLCD_BUS	T6963BusShift<>
+	#else
+		#define GLCD_BUS	T6963BusSingle<>
+	#endif
+#endif
+
+
+
+
+//*************************************************************************************************
+//	Timing
+//*************************************************************************************************
+
+// bus timing from the T6963C datasheet in ns
+#define GLCD_T_CE			80		// CE, RD and WR pulse width
+#define GLCD_T_ACC			150		// RD low to data valid
+
+// whole cpu cycles covering a time in ns, worked out at compile time
+#define GLCD_CYCLES(ns)		(((ns) * (F_CPU / 1000000UL) + 999) / 1000)
+
+// holds a strobe for a datasheet time (the pin synchronizer covers the read setup)
+#if defined(__AVR__)
+	#define GLCD_WAIT(ns)	__builtin_avr_delay_cycles(GLCD_CYCLES(ns))
+#else
+	#define GLCD_WAIT(ns)
+#endif
+
+
+
+
+#if defined(__AVR__)
+//*************************************************************************************************
+//	Ports and pins
+//*************************************************************************************************
+
+// a port is a type naming its three registers, the transports reach them through it with
+// the same single instructions as the register macros
+#define GLCD_PORT(name, port, pin, ddr) \
+	struct name \
+	{ \
+		static inline volatile uint8_t &out(void)	{ return port; } \
+		static inline volatile uint8_t &in(void)	{ return pin; } \
+		static inline volatile uint8_t &dir(void)	{ return ddr; } \
+	};
+
+#ifdef PORTA
+GLCD_PORT(T6963PortA, PORTA, PINA, DDRA)
+#endif
+#ifdef PORTB
+GLCD_PORT(T6963PortB, PORTB, PINB, DDRB)
+#endif
+#ifdef PORTC
+GLCD_PORT(T6963PortC, PORTC, PINC, DDRC)
+#endif
+#ifdef PORTD
+GLCD_PORT(T6963PortD, PORTD, PIND, DDRD)
+#endif
+#ifdef PORTE
+GLCD_PORT(T6963PortE, PORTE, PINE, DDRE)
+#endif
+#ifdef PORTF
+GLCD_PORT(T6963PortF, PORTF, PINF, DDRF)
+#endif
+#ifdef PORTG
+GLCD_PORT(T6963PortG, PORTG, PING, DDRG)
+#endif
+#ifdef PORTH
+GLCD_PORT(T6963PortH, PORTH, PINH, DDRH)
+#endif
+#ifdef PORTJ
+GLCD_PORT(T6963PortJ, PORTJ, PINJ, DDRJ)
+#endif
+#ifdef PORTK
+GLCD_PORT(T6963PortK, PORTK, PINK, DDRK)
+#endif
+#ifdef PORTL
+GLCD_PORT(T6963PortL, PORTL, PINL, DDRL)
+#endif
+
+// a single pin of a port
+template <class Port, uint8_t Bit>
+struct T6963Pin
+{
+	static inline void output(void)		{ Port::dir() |= (1 << Bit); }
+	static inline void high(void)		{ Port::out() |= (1 << Bit); }
+	static inline void low(void)		{ Port::out() &= ~(1 << Bit); }
+};
+
+
+
+
+//*************************************************************************************************
+//	Single data port
+//*************************************************************************************************
+
+// data port
+#ifndef GLCD_DATA_PORT
+	#define GLCD_DATA_PORT		T6963PortB
+#endif
+
+// control port
+#ifndef GLCD_CTRL_PORT
+	#define GLCD_CTRL_PORT		T6963PortD
+#endif
+
+// control bits
+#ifndef GLCD_WR
+	#define GLCD_WR			2
+#endif
+#ifndef GLCD_RD
+	#define GLCD_RD			3
+#endif
+#ifndef GLCD_CE
+	#define GLCD_CE			4
+#endif
+#ifndef GLCD_CD
+	#define GLCD_CD			5
+#endif
+
+// the control lines share one port so a strobe is one write to it
+template <class Data = GLCD_DATA_PORT, class Control = GLCD_CTRL_PORT,
+	uint8_t WR = GLCD_WR, uint8_t RD = GLCD_RD, uint8_t CE = GLCD_CE, uint8_t CD = GLCD_CD>
+struct T6963BusSingle
+{
+	static inline void init(void)
+	{
+		Data::dir() = 0xFF;
+		Control::dir() |= (1 << WR) | (1 << RD) | (1 << CE) | (1 << CD);
+		controlReset();
+	}
+	
+	static inline void modeRead(void)				{ Data::dir() = 0; }
+	static inline void modeWrite(void)				{ Data::dir() = 0xFF; }
+	
+	static inline uint8_t read(void)				{ return Data::in(); }
+	static inline void write(uint8_t data)			{ Data::out() = data; }
+	
+	static inline void controlReset(void)			{ Control::out() |= (1 << CE) | (1 << RD) | (1 << WR) | (1 << CD); }
+	static inline void controlReadStatus(void)		{ Control::out() &= ~((1 << CE) | (1 << RD)); }
+	static inline void controlReadData(void)		{ Control::out() &= ~((1 << CE) | (1 << RD) | (1 << CD)); }
+	static inline void controlWriteCommand(void)	{ Control::out() &= ~((1 << CE) | (1 << WR)); }
+	static inline void controlWriteData(void)		{ Control::out() &= ~((1 << CE) | (1 << WR) | (1 << CD)); }
+};
+
+
+
+
+//*************************************************************************************************
+//	Split data port
+//*************************************************************************************************
+
+// low nibble of the data on bits 0 - 3 of one port, high nibble on bits 4 - 7 of another
+#ifndef GLCD_SPLIT_LOW
+	#define GLCD_SPLIT_LOW		T6963PortC
+#endif
+#ifndef GLCD_SPLIT_HIGH
+	#define GLCD_SPLIT_HIGH		T6963PortD
+#endif
+
+#define GLCD_SPLIT_MASK1	0x0F
+#define GLCD_SPLIT_MASK2	0xF0
+
+// control pins, each can be on any port (WR is RD through an inverter, CE high keeps the
+// idle bus quiet)
+#ifndef GLCD_SPLIT_RD
+	#define GLCD_SPLIT_RD		T6963Pin<T6963PortB, 0>
+#endif
+#ifndef GLCD_SPLIT_CE
+	#define GLCD_SPLIT_CE		T6963Pin<T6963PortB, 1>
+#endif
+#ifndef GLCD_SPLIT_CD
+	#define GLCD_SPLIT_CD		T6963Pin<T6963PortB, 2>
+#endif
+
+template <class Low = GLCD_SPLIT_LOW, class High = GLCD_SPLIT_HIGH,
+	class RD = GLCD_SPLIT_RD, class CE = GLCD_SPLIT_CE, class CD = GLCD_SPLIT_CD>
+struct T6963BusSplit
+{
+	static inline void init(void)
+	{
+		modeWrite();
+		RD::output();
+		CE::output();
+		CD::output();
+		controlReset();
+	}
+	
+	static inline void modeRead(void)				{ Low::dir() &= ~GLCD_SPLIT_MASK1; High::dir() &= ~GLCD_SPLIT_MASK2; }
+	static inline void modeWrite(void)				{ Low::dir() |= GLCD_SPLIT_MASK1; High::dir() |= GLCD_SPLIT_MASK2; }
+	
+	static inline uint8_t read(void)				{ return (Low::in() & GLCD_SPLIT_MASK1) | (High::in() & GLCD_SPLIT_MASK2); }
+	
+	static inline void write(uint8_t data)
+	{
+		Low::out() = (Low::out() & ~GLCD_SPLIT_MASK1) | (data & GLCD_SPLIT_MASK1);
+		High::out() = (High::out() & ~GLCD_SPLIT_MASK2) | (data & GLCD_SPLIT_MASK2);
+	}
+	
+	static inline void controlReset(void)			{ CE::high(); CD::high(); }
+	static inline void controlReadStatus(void)		{ RD::low(); CE::low(); }
+	static inline void controlReadData(void)		{ RD::low(); CD::low(); CE::low(); }
+	static inline void controlWriteCommand(void)	{ RD::high(); CE::low(); }
+	static inline void controlWriteData(void)		{ RD::high(); CD::low(); CE::low(); }
+};
+
+
+
+
+//*************************************************************************************************
+//	Shift registers
+//*************************************************************************************************
+
+// 74HC595 drives the data lines, 74HC165 reads them back
+#ifndef GLCD_SR_PORT
+	#define GLCD_SR_PORT		T6963PortC
+#endif
+
+#ifndef GLCD_SR_DATA
+	#define GLCD_SR_DATA		0	// 595 SER
+#endif
+#ifndef GLCD_SR_CLOCK
+	#define GLCD_SR_CLOCK		1	// 595 SRCLK and 165 CLK
+#endif
+#ifndef GLCD_SR_LATCH
+	#define GLCD_SR_LATCH		2	// 595 RCLK
+#endif
+#ifndef GLCD_SR_ENABLE
+	#define GLCD_SR_ENABLE		3	// 595 /OE
+#endif
+#ifndef GLCD_SR_LOAD
+	#define GLCD_SR_LOAD		4	// 165 /PL
+#endif
+#ifndef GLCD_SR_INPUT
+	#define GLCD_SR_INPUT		5	// 165 QH
+#endif
+
+// the control lines are wired as for the single data port, the shift register lines are
+// bits of the Shift port
+template <class Shift = GLCD_SR_PORT, class Control = GLCD_CTRL_PORT,
+	uint8_t WR = GLCD_WR, uint8_t RD = GLCD_RD, uint8_t CE = GLCD_CE, uint8_t CD = GLCD_CD,
+	uint8_t SER = GLCD_SR_DATA, uint8_t CLK = GLCD_SR_CLOCK, uint8_t RCLK = GLCD_SR_LATCH,
+	uint8_t OE = GLCD_SR_ENABLE, uint8_t PL = GLCD_SR_LOAD, uint8_t QH = GLCD_SR_INPUT>
+struct T6963BusShift
+{
+	typedef T6963BusSingle<Control, Control, WR, RD, CE, CD> Lines;
+	
+	static inline void init(void)
+	{
+		Shift::dir() |= (1 << SER) | (1 << CLK) | (1 << RCLK) | (1 << OE) | (1 << PL);
+		Shift::dir() &= ~(1 << QH);
+		Shift::out() |= (1 << PL);
+		modeWrite();
+		Control::dir() |= (1 << WR) | (1 << RD) | (1 << CE) | (1 << CD);
+		controlReset();
+	}
+	
+	static inline void modeRead(void)				{ Shift::out() |= (1 << OE); }
+	static inline void modeWrite(void)				{ Shift::out() &= ~(1 << OE); }
+	
+	// the 165 loads while the read strobe is still low, D7 comes out first
+	static inline uint8_t read(void)
+	{
+		uint8_t data, bit;
+		
+		Shift::out() &= ~(1 << PL);
+		Shift::out() |= (1 << PL);
+		
+		data = 0;
+		
+		for (bit = 0; bit < 8; bit++)
+		{
+			data = (data << 1) | ((Shift::in() >> QH) & 0x01);
+			Shift::out() |= (1 << CLK);
+			Shift::out() &= ~(1 << CLK);
+		}
+		
+		return data;
+	}
+	
+	static inline void write(uint8_t data)
+	{
+		uint8_t bit;
+		
+		for (bit = 0x80; bit; bit >>= 1)
+		{
+			if (data & bit)
+			{
+				Shift::out() |= (1 << SER);
+			}
+			else
+			{
+				Shift::out() &= ~(1 << SER);
+			}
+			
+			Shift::out() |= (1 << CLK);
+			Shift::out() &= ~(1 << CLK);
+		}
+		
+		Shift::out() |= (1 << RCLK);
+		Shift::out() &= ~(1 << RCLK);
+	}
+	
+	static inline void controlReset(void)			{ Lines::controlReset(); }
+	static inline void controlReadStatus(void)		{ Lines::controlReadStatus(); }
+	static inline void controlReadData(void)		{ Lines::controlReadData(); }
+	static inline void controlWriteCommand(void)	{ Lines::controlWriteCommand(); }
+	static inline void controlWriteData(void)		{ Lines::controlWriteData(); }
+};
+#endif
+
+
+
+
+//*************************************************************************************************
+//	Host
+//*************************************************************************************************
+
+// bus cycles go to these functions, a host build links a model of the controller
+// (status is 1 for status reads and command writes)
+uint8_t t6963HostRead(uint8_t status);
+void t6963HostWrite(uint8_t command, uint8_t data);
+
+struct T6963BusHost
+{
+	static uint8_t _data;
+	
+	static inline void init(void)					{ }
+	
+	static inline void modeRead(void)				{ }
+	static inline void modeWrite(void)				{ }
+	
+	static inline uint8_t read(void)				{ return _data; }
+	static inline void write(uint8_t data)			{ _data = data; }
+	
+	static inline void controlReset(void)			{ }
+	static inline void controlReadStatus(void)		{ _data = t6963HostRead(1); }
+	static inline void controlReadData(void)		{ _data = t6963HostRead(0); }
+	static inline void controlWriteCommand(void)	{ t6963HostWrite(1, _data); }
+	static inline void controlWriteData(void)		{ t6963HostWrite(0, _data); }
+};
+
+#endif
@@ -1,3 +1,8 @@
+#define T6963_STATUS_COMMAND		0x01
+#define T6963_STATUS_DATA		0x02
+#define T6963_STATUS_AUTO_READ		0x04
+#define T6963_STATUS_AUTO_WRITE		0x08
+
 #define T6963_SET_CURSOR_POINTER	0x21
 #define T6963_SET_OFFSET_REGISTER	0x22
 #define T6963_SET_ADDRESS_POINTER	0x24
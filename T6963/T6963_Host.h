@@ -0,0 +1,29 @@
+/*
+	Host stand-ins for the avr-libc parts used by the T6963 library
+
+	Included by T6963.h when it is not built for an AVR, so the library compiles
+	unchanged on a desktop machine. The bus goes to t6963HostRead() and
+	t6963HostWrite() (see T6963_Bus.h), host/T6963_Emulator.cpp models a controller
+	behind them.
+*/
+
+#ifndef T6963_HOST_H
+#define T6963_HOST_H
+
+#include <stdint.h>
+#include <string.h>
+
+// program memory is ordinary memory
+#define PROGMEM
+#define PSTR(s)				(s)
+#define pgm_read_byte(p)	(*(const uint8_t*)(p))
+#define pgm_read_word(p)	(*(const uint16_t*)(p))
+#define strlen_P(s)			strlen((const char*)(s))
+
+typedef char prog_char;
+
+// nothing to wait for without a panel
+static inline void _delay_ms(double)	{ }
+static inline void _delay_us(double)	{ }
+
+#endif
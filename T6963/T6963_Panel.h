@@ -0,0 +1,5425 @@
+/*
+	Member functions of the T6963Panel template
+
+	Included at the end of T6963.h, so a panel of any size, memory or bus declared
+	in a sketch gets its own code from there. The macros below are only for these
+	definitions and are undefined again at the end.
+*/
+
+#ifndef T6963_PANEL_H
+#define T6963_PANEL_H
+
+
+//*************************************************************************************************
+//	Libraries
+//*************************************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+
+
+//*************************************************************************************************
+//	Macro definitions
+//*************************************************************************************************
+
+#define GLCD_TEMPLATE	template <uint8_t Width, uint8_t Height, uint8_t Font, uint8_t Memory, class Bus>
+#define GLCD_PANEL		T6963Panel<Width, Height, Font, Memory, Bus>
+
+// data port macros (the bus transport is picked in T6963_Bus.h)
+#define GLCD_SET_PORT_MODE_READ		Bus::modeRead()
+#define GLCD_SET_PORT_MODE_WRITE	Bus::modeWrite()
+
+#define GLCD_ReadPort(data)			(data = Bus::read())
+#define GLCD_WritePort(data)		Bus::write(data)
+
+// control macros
+#define GLCD_CONTROL_RESET			Bus::controlReset()
+#define GLCD_CONTROL_READ_STATUS	Bus::controlReadStatus()
+#define GLCD_CONTROL_READ_DATA		Bus::controlReadData()
+#define GLCD_CONTROL_WRITE_COMMAND	Bus::controlWriteCommand()
+#define GLCD_CONTROL_WRITE_DATA		Bus::controlWriteData()
+
+
+#define GLCD_WriteWord(data, cmd)	(writeData(0xFF & (data)), writeData((data) >> 8), writeCommand(cmd))
+#define GLCD_SetAddress(addr)		GLCD_WriteWord(addr, T6963_SET_ADDRESS_POINTER)
+
+#define GLCD_MASK(low, high)		((uint8_t)((2 << (high)) - (1 << (low))))
+
+// kinds of queued bus cycles, kept in the high byte of a queue entry
+#define GLCD_QUEUE_COMMAND			0
+#define GLCD_QUEUE_DATA				1
+#define GLCD_QUEUE_AUTO				2
+#define GLCD_QUEUE_RESET			3
+#define GLCD_QUEUE_RESET_READ		4
+
+// polygon edge table growth in edges
+#define GLCD_EDGE_CHUNK				8
+
+// outcode bits for the edges of the clip rectangle
+#define GLCD_CLIP_LEFT				0x01
+#define GLCD_CLIP_RIGHT				0x02
+#define GLCD_CLIP_TOP				0x04
+#define GLCD_CLIP_BOTTOM			0x08
+
+// ascii maps onto the rom font, codes 0x80 and up are the glyphs in CG ram
+#define GLCD_CharCode(c)			((uint8_t)(c) & 0x80 ? (uint8_t)(c) : (uint8_t)(c) - 32)
+
+// graphic column of pixel x and its bit in the column byte (fontWidth - 1 is the left pixel),
+// font widths that are not a power of two look them up instead of dividing
+#define GLCD_POW2_FONT				((fontWidth & (fontWidth - 1)) == 0)
+#define GLCD_COLUMN(x)				(GLCD_POW2_FONT ? (uint8_t)(x) / fontWidth : pgm_read_byte(&T6963Columns<Font>::column[(uint8_t)(x)]))
+#define GLCD_BIT(x)					(GLCD_POW2_FONT ? fontWidth - 1 - (uint8_t)(x) % fontWidth : pgm_read_byte(&T6963Columns<Font>::bit[(uint8_t)(x)]))
+
+
+// smaller, larger and clamped values, prefixed so the sketch's min() and max() are left alone
+#define GLCD_MIN(a, b)				((a) < (b) ? (a) : (b))
+#define GLCD_MAX(a, b)				((a) > (b) ? (a) : (b))
+#define GLCD_CONSTRAIN(x, low, high)	((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+
+
+
+
+
+
+//*************************************************************************************************
+//	Pixel Column Tables
+//*************************************************************************************************
+
+#define GLCD_TABLE_4(f, x)			f(x), f(x + 1), f(x + 2), f(x + 3)
+#define GLCD_TABLE_16(f, x)			GLCD_TABLE_4(f, x), GLCD_TABLE_4(f, x + 4), GLCD_TABLE_4(f, x + 8), GLCD_TABLE_4(f, x + 12)
+#define GLCD_TABLE_64(f, x)			GLCD_TABLE_16(f, x), GLCD_TABLE_16(f, x + 16), GLCD_TABLE_16(f, x + 32), GLCD_TABLE_16(f, x + 48)
+#define GLCD_TABLE_256(f)			GLCD_TABLE_64(f, 0), GLCD_TABLE_64(f, 64), GLCD_TABLE_64(f, 128), GLCD_TABLE_64(f, 192)
+
+#define GLCD_TABLE_COLUMN(x)		((x) / Font)
+#define GLCD_TABLE_BIT(x)			(Font - 1 - (x) % Font)
+
+template <uint8_t Font>
+const uint8_t T6963Columns<Font>::column[256] PROGMEM = { GLCD_TABLE_256(GLCD_TABLE_COLUMN) };
+
+template <uint8_t Font>
+const uint8_t T6963Columns<Font>::bit[256] PROGMEM = { GLCD_TABLE_256(GLCD_TABLE_BIT) };
+
+
+
+
+
+
+//*************************************************************************************************
+//	Global functions
+//*************************************************************************************************
+
+//Big digit tables and bit packing (T6963.cpp)
+extern const uint8_t bigSegments[8][4] PROGMEM;
+extern const uint8_t bigDigits[10] PROGMEM;
+extern const uint8_t bigCells[9] PROGMEM;
+extern const uint8_t bigOffsets[9] PROGMEM;
+
+uint8_t packBits(uint8_t, uint8_t);
+uint8_t spreadBits(uint8_t, uint8_t);
+
+//-------------------------------------------------------------------------------------------------
+//
+// Shift the next column of pixels out of a bitmap row in program memory
+//
+//	Input	**bitmap: pointer to the next bitmap byte
+//			*count: bitmap bytes left in the row
+//			*buffer: pixels read but not shifted out yet (left aligned)
+//			*bits: number of pixels in the buffer
+//
+//	Output	column of pixels
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::shiftColumn(const uint8_t **bitmap, uint8_t *count, uint16_t *buffer, uint8_t *bits)
+{
+	uint8_t data;
+	
+	while (*bits < fontWidth)
+	{
+		if (*count > 0)
+		{
+			*buffer |= (uint16_t)pgm_read_byte(*bitmap) << (8 - *bits);
+			(*bitmap)++;
+			(*count)--;
+		}
+		
+		*bits += 8;
+	}
+	
+	data = *buffer >> (16 - fontWidth);
+	*buffer <<= fontWidth;
+	*bits -= fontWidth;
+	
+	return data;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Render one glyph row of a big digit cell
+//
+//	Input	x: left pixel of the cell in the digit
+//			y: pixel row in the digit
+//			segments: segments lit
+//
+//	Output	glyph row (fontWidth low bits)
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::bigRow(uint8_t x, uint8_t y, uint8_t segments)
+{
+	uint8_t data, bit, column, i;
+	
+	data = 0;
+	
+	for (i = 0; i < 8; i++)
+	{
+		if ((segments & (1 << i)) == 0 ||
+			y < pgm_read_byte(&bigSegments[i][1]) || y > pgm_read_byte(&bigSegments[i][3]))
+		{
+			continue;
+		}
+		
+		for (bit = 0; bit < fontWidth; bit++)
+		{
+			column = (x + bit) * 6 / fontWidth;
+			
+			if (column >= pgm_read_byte(&bigSegments[i][0]) && column <= pgm_read_byte(&bigSegments[i][2]))
+			{
+				data |= 1 << (fontWidth - 1 - bit);
+			}
+		}
+	}
+	
+	return data;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Take a column of pixels from a row of display bytes at any pixel offset
+//
+//	Input	*buffer: display bytes
+//			size: number of bytes
+//			index: byte the column ends in
+//			shift: pixels of the column taken from the end of the byte before
+//
+//	Output	column of pixels (pixels outside the buffer are 0)
+//
+//	The next column is at index + 1 with the same shift, so callers step
+//	along a row without dividing
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::copyColumn(const uint8_t *buffer, uint8_t size, uint8_t index, uint8_t shift)
+{
+	uint16_t window;
+	
+	window = 0;
+	
+	if (index > 0 && index <= size)
+	{
+		window = (buffer[index - 1] & GLCD_MASK(0, fontWidth - 1)) << fontWidth;
+	}
+	
+	if (index < size)
+	{
+		window |= buffer[index] & GLCD_MASK(0, fontWidth - 1);
+	}
+	
+	return (window >> (fontWidth - shift)) & GLCD_MASK(0, fontWidth - 1);
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//	Basic I/O Functions
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Poll the controller status until all of the bits are set
+//
+//	Input	mask: status bits to wait for
+//
+//	Output	none
+//
+//	The data port is left as input, writes turn it back around themselves
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::waitStatus(uint8_t mask)
+{
+	uint8_t tmp;
+	
+	GLCD_SET_PORT_MODE_READ;
+	
+	do
+	{
+		GLCD_CONTROL_READ_STATUS;
+		
+		GLCD_WAIT(GLCD_T_ACC);
+		GLCD_ReadPort(tmp);
+		
+		GLCD_CONTROL_RESET;
+	}
+	while ((tmp & mask) != mask);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read data from the controller
+//
+//	Input	none
+//
+//	Output	data read
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::readData(void)
+{
+	uint8_t tmp;
+	
+#ifdef GLCD_QUEUE
+	//Everything written before has to reach the controller first
+	sync();
+#endif
+
+	waitStatus(T6963_STATUS_COMMAND | T6963_STATUS_DATA);
+	
+	GLCD_CONTROL_READ_DATA;
+	
+	GLCD_WAIT(GLCD_T_ACC);
+	GLCD_ReadPort(tmp);
+	
+	GLCD_CONTROL_RESET;
+	GLCD_SET_PORT_MODE_WRITE;
+	
+	_ready = 0;
+	
+	return tmp;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write a command to the controller
+//
+//	Input	command: the command to send
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeCommand(uint8_t command)
+{
+#ifdef GLCD_QUEUE
+	queue(GLCD_QUEUE_COMMAND, command);
+#else
+	//A command always waits for STA0 and STA1, even after its arguments
+	waitStatus(T6963_STATUS_COMMAND | T6963_STATUS_DATA);
+	GLCD_SET_PORT_MODE_WRITE;
+	
+	GLCD_WritePort(command);
+	GLCD_CONTROL_WRITE_COMMAND;
+	
+	GLCD_WAIT(GLCD_T_CE);
+	
+	GLCD_CONTROL_RESET;
+	
+	//The command runs after the strobe, the next cycle has to wait for it
+	_ready = 0;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write data to the controller
+//
+//	Input	data: the data to send
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeData(uint8_t data)
+{
+#ifdef GLCD_QUEUE
+	queue(GLCD_QUEUE_DATA, data);
+#else
+	if (!_ready)
+	{
+		waitStatus(T6963_STATUS_COMMAND | T6963_STATUS_DATA);
+		GLCD_SET_PORT_MODE_WRITE;
+	}
+	
+	GLCD_WritePort(data);
+	GLCD_CONTROL_WRITE_DATA;
+	
+	GLCD_WAIT(GLCD_T_CE);
+	
+	GLCD_CONTROL_RESET;
+	
+#ifdef GLCD_SKIP_STATUS
+	//Trust the controller to take the next argument without a check (outside the datasheet)
+	_ready = 1;
+#endif
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write data to the controller while in auto write mode
+//
+//	Input	data: the data to send
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeAuto(uint8_t data)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		frameWrite(data);
+		_pointer++;
+		return;
+	}
+#endif
+
+#ifdef GLCD_QUEUE
+	queue(GLCD_QUEUE_AUTO, data);
+#else
+	waitStatus(T6963_STATUS_AUTO_WRITE);
+	GLCD_SET_PORT_MODE_WRITE;
+	
+	GLCD_WritePort(data);
+	GLCD_CONTROL_WRITE_DATA;
+	
+	GLCD_WAIT(GLCD_T_CE);
+	
+	GLCD_CONTROL_RESET;
+#endif
+
+	_pointer++;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read data from the controller while in auto read mode
+//
+//	Input	none
+//
+//	Output	data read
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::readAuto(void)
+{
+	uint8_t tmp;
+	
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		tmp = frameRead();
+		_pointer++;
+		return tmp;
+	}
+#endif
+
+#ifdef GLCD_QUEUE
+	sync();
+#endif
+
+	waitStatus(T6963_STATUS_AUTO_READ);
+	
+	GLCD_CONTROL_READ_DATA;
+	
+	GLCD_WAIT(GLCD_T_ACC);
+	GLCD_ReadPort(tmp);
+	
+	GLCD_CONTROL_RESET;
+	GLCD_SET_PORT_MODE_WRITE;
+	
+	_pointer++;
+	
+	return tmp;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Enter auto write mode
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::autoWrite(void)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		return;
+	}
+#endif
+
+	_autoStatus = T6963_STATUS_AUTO_WRITE;
+	writeCommand(T6963_SET_DATA_AUTO_WRITE);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Enter auto read mode
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::autoRead(void)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		return;
+	}
+#endif
+
+	_autoStatus = T6963_STATUS_AUTO_READ;
+	writeCommand(T6963_SET_DATA_AUTO_READ);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Leave auto read or auto write mode
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::autoReset(void)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		return;
+	}
+#endif
+
+#ifdef GLCD_QUEUE
+	queue((_autoStatus == T6963_STATUS_AUTO_READ) ? GLCD_QUEUE_RESET_READ : GLCD_QUEUE_RESET, T6963_AUTO_RESET);
+#else
+	waitStatus(_autoStatus);
+	GLCD_SET_PORT_MODE_WRITE;
+	
+	GLCD_WritePort(T6963_AUTO_RESET);
+	GLCD_CONTROL_WRITE_COMMAND;
+	
+	GLCD_WAIT(GLCD_T_CE);
+	
+	GLCD_CONTROL_RESET;
+#endif
+}
+
+
+#ifdef GLCD_QUEUE
+//-------------------------------------------------------------------------------------------------
+//
+// Add a bus cycle to the queue
+//
+//	Input	kind: GLCD_QUEUE_COMMAND, GLCD_QUEUE_DATA, GLCD_QUEUE_AUTO, or
+//				GLCD_QUEUE_RESET / GLCD_QUEUE_RESET_READ to leave auto write / auto read
+//			data: the byte to send
+//
+//	Output	none
+//
+//	A full queue is drained here, so the caller only waits when it draws
+//	faster than service() keeps up
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::queue(uint8_t kind, uint8_t data)
+{
+	uint8_t next;
+	
+	next = (_queueHead + 1) & (GLCD_QUEUE_SIZE - 1);
+	
+	while (next == _queueTail)
+	{
+		service();
+	}
+	
+	//The entry is complete before the head moves past it
+	_queue[_queueHead] = (kind << 8) | data;
+	_queueHead = next;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Send queued bus cycles while the controller is ready
+//
+//	Input	none
+//
+//	Output	none
+//
+//	Safe to call from a timer interrupt. It reads the status once per
+//	cycle and returns as soon as the controller is busy, after
+//	GLCD_QUEUE_BURST cycles, or when it interrupted itself
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::service(void)
+{
+	uint16_t entry;
+	uint8_t count, kind, mask, tmp;
+	
+	if (_serving)
+	{
+		return;
+	}
+	
+	_serving = 1;
+	
+	for (count = 0; count < GLCD_QUEUE_BURST && _queueTail != _queueHead; count++)
+	{
+		entry = _queue[_queueTail];
+		kind = entry >> 8;
+		
+#ifdef GLCD_SKIP_STATUS
+		//Same as writeData(), only an argument following an argument goes without the check
+		if (kind != GLCD_QUEUE_DATA)
+		{
+			_ready = 0;
+		}
+#endif
+
+		if (!_ready)
+		{
+			switch (kind)
+			{
+				case GLCD_QUEUE_AUTO:
+				case GLCD_QUEUE_RESET:
+					mask = T6963_STATUS_AUTO_WRITE;
+					break;
+					
+				case GLCD_QUEUE_RESET_READ:
+					mask = T6963_STATUS_AUTO_READ;
+					break;
+					
+				default:
+					mask = T6963_STATUS_COMMAND | T6963_STATUS_DATA;
+					break;
+			}
+			
+			GLCD_SET_PORT_MODE_READ;
+			
+			GLCD_CONTROL_READ_STATUS;
+			
+			GLCD_WAIT(GLCD_T_ACC);
+			GLCD_ReadPort(tmp);
+			
+			GLCD_CONTROL_RESET;
+			
+			if ((tmp & mask) != mask)
+			{
+				break;
+			}
+			
+			GLCD_SET_PORT_MODE_WRITE;
+		}
+		
+		GLCD_WritePort(entry & 0xFF);
+		
+		if (kind != GLCD_QUEUE_DATA && kind != GLCD_QUEUE_AUTO)
+		{
+			GLCD_CONTROL_WRITE_COMMAND;
+		}
+		else
+		{
+			GLCD_CONTROL_WRITE_DATA;
+		}
+		
+		GLCD_WAIT(GLCD_T_CE);
+		
+		GLCD_CONTROL_RESET;
+		
+#ifdef GLCD_SKIP_STATUS
+		_ready = (kind == GLCD_QUEUE_DATA);
+#endif
+
+		_queueTail = (_queueTail + 1) & (GLCD_QUEUE_SIZE - 1);
+	}
+	
+	_serving = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Number of bus cycles still in the queue
+//
+//	Input	none
+//
+//	Output	queued cycles
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::pending(void)
+{
+	return (_queueHead - _queueTail) & (GLCD_QUEUE_SIZE - 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Wait until everything queued has reached the controller
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::sync(void)
+{
+	while (_queueTail != _queueHead)
+	{
+		service();
+	}
+}
+#endif
+
+#ifdef GLCD_FRAMEBUFFER
+//-------------------------------------------------------------------------------------------------
+//
+// Read the framebuffer at the address pointer
+//
+//	Input	none
+//
+//	Output	data read
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::frameRead(void)
+{
+	if (_pointer < _graph || _pointer >= _graph + graphArea)
+	{
+		return 0;
+	}
+	
+	return _frame[_pointer - _graph];
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write the framebuffer at the address pointer and mark the byte dirty
+//
+//	Input	data: write data
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::frameWrite(uint8_t data)
+{
+	uint16_t index;
+	uint8_t x, y;
+	
+	if (_pointer < _graph || _pointer >= _graph + graphArea)
+	{
+		return;
+	}
+	
+	index = _pointer - _graph;
+	
+	if (_frame[index] == data)
+	{
+		return;
+	}
+	
+	_frame[index] = data;
+	
+	// the row steps from the one written last, only a jump of more than a row divides
+	if (index >= _frameStart + graphWidth && index < _frameStart + 2 * graphWidth)
+	{
+		_frameStart += graphWidth;
+		_frameRow++;
+	}
+	else if (index < _frameStart && index + graphWidth >= _frameStart)
+	{
+		_frameStart -= graphWidth;
+		_frameRow--;
+	}
+	else if (index < _frameStart || index >= _frameStart + graphWidth)
+	{
+		_frameRow = index / graphWidth;
+		_frameStart = _frameRow * graphWidth;
+	}
+	
+	y = _frameRow;
+	x = index - _frameStart;
+	
+	_dirtyLeft[y] = GLCD_MIN(_dirtyLeft[y], x);
+	_dirtyRight[y] = GLCD_MAX(_dirtyRight[y], x);
+}
+#endif
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Basic Controller Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set display mode
+//
+//	Input	mode: the display mode
+//			CG: location of character graphics
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setMode(uint8_t mode, uint8_t CG)
+{
+	writeCommand(T6963_MODE_SET | CG | mode);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set display settings
+//
+//	Input	settings: the display settings
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setDisplay(uint8_t settings)
+{
+	writeCommand(T6963_DISPLAY_MODE | settings);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Show a graphic page
+//
+//	Input	page: page to show (0 to graphPages - 1)
+//
+//	Output	none
+//
+//	init() only clears page 0, clear the others with clearGraph() before showing them
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setShowPage(uint8_t page)
+{
+	if (page < graphPages)
+	{
+		_showPage = page;
+		GLCD_WriteWord((graphStart + (page) * graphArea), T6963_SET_GRAPHIC_HOME_ADDRESS);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw on a graphic page
+//
+//	Input	page: page to draw on (0 to graphPages - 1)
+//
+//	Output	none
+//
+//	The drawing position stays at the same x, y on the new page
+//	With GLCD_FRAMEBUFFER the ram copy is flushed to the old page and the
+//	next flush rewrites all of the new page
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setDrawPage(uint8_t page)
+{
+	if (page < graphPages && page != _drawPage)
+	{
+#ifdef GLCD_FRAMEBUFFER
+		flush();
+		memset(_dirtyLeft, 0, graphHeight);
+		memset(_dirtyRight, graphWidth - 1, graphHeight);
+#endif
+
+		_address += (graphStart + (page) * graphArea) - _graph;
+		_graph = (graphStart + (page) * graphArea);
+		_drawPage = page;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Show the page being drawn on and draw on the page that was shown
+//
+//	Input	none
+//
+//	Output	none
+//
+//	With one page both are the same and only a flush is done
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::flipPage(void)
+{
+	uint8_t page;
+	
+	flush();
+	
+	page = _showPage;
+	setShowPage(_drawPage);
+	setDrawPage(page);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set the address pointer in display memory
+//
+//	Input	none
+//
+//	Output	none
+//
+//	The drawing functions only move the address pointer when they next
+//	touch memory, call this before using the byte functions directly
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setAddress(void)
+{
+	setPointer(_address);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set the text address pointer in display memory
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setText(void)
+{
+	setPointer(_text);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Move the controller's address pointer
+//
+//	Input	address: new address
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setPointer(uint16_t address)
+{
+#ifdef GLCD_FRAMEBUFFER
+	// graphic memory is drawn in ram, the controller's pointer waits in _device
+	if (address >= _graph && address < _graph + graphArea)
+	{
+		if (!_virtual)
+		{
+			_device = _pointer;
+			_virtual = 1;
+		}
+		
+		_pointer = address;
+		return;
+	}
+	
+	if (_virtual)
+	{
+		_pointer = _device;
+		_virtual = 0;
+	}
+#endif
+
+	if (address == _pointer)
+	{
+		return;
+	}
+	
+#ifndef GLCD_QUEUE
+	// a read that steps the pointer costs one bus cycle less than setting it
+	// (not with the queue, the read would have to wait for it to empty)
+	if (address == _pointer + 1)
+	{
+		readByteInc();
+		return;
+	}
+	
+	if (address == _pointer - 1)
+	{
+		readByteDec();
+		return;
+	}
+#endif
+
+	GLCD_SetAddress(address);
+	_pointer = address;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set the screen cursor position
+//
+//	Input	col: cursor column 
+//			row: cursor row
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setCursorPointer(uint8_t col, uint8_t row)
+{
+	col = GLCD_CONSTRAIN(col, 0, (textWidth - 1));
+	row = GLCD_CONSTRAIN(row, 0, (textHeight - 1));
+	writeData(col);
+	writeData(row);
+	writeCommand(T6963_SET_CURSOR_POINTER);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Sets cursor Pattern
+//
+//	Input	cursor: the cursor pattern
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setCursorPattern(uint8_t cursor)
+{
+	writeCommand(T6963_CURSOR_PATTERN_SELECT | GLCD_CONSTRAIN(cursor, 0, 7));
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read display data
+//
+//	Input	none
+//
+//	Output	data read
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::readByte(void)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		return frameRead();
+	}
+#endif
+
+	writeCommand(T6963_DATA_READ_AND_NONVARIABLE);
+	return readData();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read display data and increment address pointer
+//
+//	Input	none
+//
+//	Output	data read
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::readByteInc(void)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		uint8_t tmp;
+		
+		tmp = frameRead();
+		_pointer++;
+		return tmp;
+	}
+#endif
+
+	writeCommand(T6963_DATA_READ_AND_INCREMENT);
+	_pointer++;
+	return readData();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read display data and decrement address pointer
+//
+//	Input	none
+//
+//	Output	data read
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::readByteDec(void)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		uint8_t tmp;
+		
+		tmp = frameRead();
+		_pointer--;
+		return tmp;
+	}
+#endif
+
+	writeCommand(T6963_DATA_READ_AND_DECREMENT);
+	_pointer--;
+	return readData();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write display data
+//
+//	Input	data: write data
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeByte(uint8_t data)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		frameWrite(data);
+		return;
+	}
+#endif
+
+	writeData(data);
+	writeCommand(T6963_DATA_WRITE_AND_NONVARIABLE);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write display data and increment address pointer
+//
+//	Input	data: write data
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeByteInc(uint8_t data)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		frameWrite(data);
+		_pointer++;
+		return;
+	}
+#endif
+
+	writeData(data);
+	writeCommand(T6963_DATA_WRITE_AND_INCREMENT);
+	_pointer++;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write display data and decrement address pointer
+//
+//	Input	data: write data
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeByteDec(uint8_t data)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		frameWrite(data);
+		_pointer--;
+		return;
+	}
+#endif
+
+	writeData(data);
+	writeCommand(T6963_DATA_WRITE_AND_DECREMENT);
+	_pointer--;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write to a single bit
+//
+//	Input	data: write data
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeBit(uint8_t data)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		if (data & T6963_BIT_SET)
+		{
+			frameWrite(frameRead() | (1 << (data & 0x07)));
+		}
+		else
+		{
+			frameWrite(frameRead() & ~(1 << (data & 0x07)));
+		}
+		
+		return;
+	}
+#endif
+
+	writeCommand(T6963_SET_PIXEL | data);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write the current color to the masked bits of a byte
+//
+//	Input	mask: bits to write
+//			command: write command to store the byte with (sets how the address pointer moves)
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeMask(uint8_t mask, uint8_t command)
+{
+	writeMask(_color ? 0xFF : 0, mask, command);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write data to the masked bits of a byte
+//
+//	Input	data: write data
+//			mask: bits to write
+//			command: write command to store the byte with (sets how the address pointer moves)
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeMask(uint8_t data, uint8_t mask, uint8_t command)
+{
+#ifdef GLCD_FRAMEBUFFER
+	if (_virtual)
+	{
+		frameWrite((frameRead() & ~mask) | (data & mask));
+		
+		if (command == T6963_DATA_WRITE_AND_INCREMENT)
+		{
+			_pointer++;
+		}
+		else if (command == T6963_DATA_WRITE_AND_DECREMENT)
+		{
+			_pointer--;
+		}
+		
+		return;
+	}
+#endif
+
+	// a few pixels that leave the address pointer in place are cheaper as bit commands
+	if (command == T6963_DATA_WRITE_AND_NONVARIABLE)
+	{
+		uint8_t bits, count;
+		
+		for (bits = mask, count = 0; bits; bits &= bits - 1)
+		{
+			count++;
+		}
+		
+		if (count < 4)
+		{
+			for (count = 0; mask; mask >>= 1, data >>= 1, count++)
+			{
+				if (mask & 0x01)
+				{
+					writeCommand(T6963_SET_PIXEL | ((data & 0x01) ? T6963_BIT_SET : T6963_BIT_RESET) | count);
+				}
+			}
+			
+			return;
+		}
+	}
+	
+	data = (readByte() & ~mask) | (data & mask);
+	
+	writeData(data);
+	writeCommand(command);
+	
+	if (command == T6963_DATA_WRITE_AND_INCREMENT)
+	{
+		_pointer++;
+	}
+	else if (command == T6963_DATA_WRITE_AND_DECREMENT)
+	{
+		_pointer--;
+	}
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write a byte of data to a block of memory
+//
+//	Input	data: byte of data
+//			size: length of write
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeBlock(uint8_t data, uint16_t size)
+{
+	// auto write costs two extra commands, so short blocks are cheaper a byte at a time
+	if (size < 3)
+	{
+		while (size > 0)
+		{
+			writeByteInc(data);
+			size--;
+		}
+		
+		return;
+	}
+	
+	autoWrite();
+	
+	while (size > 0)
+	{
+		writeAuto(data);
+		size--;
+	}
+	
+	autoReset();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read a block of memory
+//
+//	Input	*buffer: buffer to fill
+//			size: length of read
+//
+//	Output	none
+//
+//	The address pointer is left after the last byte read
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::readBlock(uint8_t *buffer, uint16_t size)
+{
+	// auto read costs two extra commands, so short blocks are cheaper a byte at a time
+	if (size < 3)
+	{
+		while (size > 0)
+		{
+			*buffer = readByteInc();
+			buffer++;
+			size--;
+		}
+		
+		return;
+	}
+	
+	autoRead();
+	
+	while (size > 0)
+	{
+		*buffer = readAuto();
+		buffer++;
+		size--;
+	}
+	
+	autoReset();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read a row of graphic memory
+//
+//	Input	*buffer: buffer to fill (graphWidth bytes)
+//			y: row to read
+//
+//	Output	none
+//
+//	The address pointer is not restored, it is left after the row
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::readRow(uint8_t *buffer, uint8_t y)
+{
+	readRow(buffer, y, 0, graphWidth);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read part of a row of graphic memory
+//
+//	Input	*buffer: buffer to fill
+//			y: row to read
+//			col: first column to read
+//			size: number of columns to read
+//
+//	Output	none
+//
+//	The address pointer is not restored, it is left after the last column
+//	read, so a caller that writes next sets it again (copyRegion() does)
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::readRow(uint8_t *buffer, uint8_t y, uint8_t col, uint8_t size)
+{
+	if (y < screenHeight && col < graphWidth)
+	{
+		size = GLCD_MIN(size, graphWidth - col);
+		
+		setPointer(_graph + graphWidth * y + col);
+		readBlock(buffer, size);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Send the dirty parts of the framebuffer to the controller
+//
+//	Input	none
+//
+//	Output	none
+//
+//	Only does something with GLCD_FRAMEBUFFER, the dirty range of each row is
+//	sent with auto write and ranges up to GLCD_FRAME_GAP bytes apart share one
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::flush(void)
+{
+#ifdef GLCD_FRAMEBUFFER
+	uint16_t address, end;
+	uint8_t y, open;
+	
+	if (_virtual)
+	{
+		_pointer = _device;
+		_virtual = 0;
+	}
+	
+	open = 0;
+	
+	for (y = 0; y < graphHeight; y++)
+	{
+		if (_dirtyLeft[y] > _dirtyRight[y])
+		{
+			continue;
+		}
+		
+		address = _graph + graphWidth * y + _dirtyLeft[y];
+		end = _graph + graphWidth * y + _dirtyRight[y] + 1;
+		
+		_dirtyLeft[y] = 0xFF;
+		_dirtyRight[y] = 0;
+		
+		if (!open || address < _pointer || address - _pointer > GLCD_FRAME_GAP)
+		{
+			if (open)
+			{
+				autoReset();
+			}
+			
+			// setPointer() would stay in the framebuffer
+			if (address != _pointer)
+			{
+				GLCD_SetAddress(address);
+				_pointer = address;
+			}
+			
+			autoWrite();
+			open = 1;
+		}
+		
+		while (_pointer < end)
+		{
+			writeAuto(_frame[_pointer - _graph]);
+		}
+	}
+	
+	if (open)
+	{
+		autoReset();
+	}
+#endif
+}
+
+
+
+
+/*
+//-------------------------------------------------------------------------------------------------
+//
+// Write a byte of data to a block of memory
+//
+//	Input	data: byte of data
+//			width: width of write
+//			height: height of write
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeBlock(uint8_t data, uint8_t width, uint8_t height)
+{
+	if (width <  graphWidth)
+	{
+		uint8_t mem = graphWidth - width;
+		
+		while (height > 0)
+		{
+			uint8_t size;
+			
+			for (size = width; size > 0; size--)
+			{
+				writeData(data);
+				writeCommand(T6963_DATA_WRITE_AND_INCREMENT);
+			}
+			
+			_address += mem;
+			setAddress();
+			
+			height--;
+		}
+	}
+}
+*/
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Primative Drawing Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a horizontal line
+//
+//	Input	length: line length
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::horizLine(int16_t length)
+{
+	uint8_t data;
+	uint16_t col;
+	
+	data = _color ? 0xFF : 0;
+	
+	setAddress();
+	
+	if (length > 0)
+	{
+		// a span ending on the byte boundary leaves the step to the next byte for later
+		if (length <= _bit + 1)
+		{
+			writeMask(GLCD_MASK(_bit + 1 - length, _bit), T6963_DATA_WRITE_AND_NONVARIABLE);
+			
+			if (length > _bit)
+			{
+				_bit = fontWidth - 1;
+				_address++;
+			}
+			else
+			{
+				_bit -= length;
+			}
+			
+			return;
+		}
+		
+		if (_bit < fontWidth - 1)
+		{
+			length -= _bit + 1;
+			writeMask(GLCD_MASK(0, _bit), T6963_DATA_WRITE_AND_INCREMENT);
+			_address++;
+		}
+		
+		col = length / fontWidth;
+		length -= col * fontWidth;
+		
+		writeBlock(data, col);
+		_address += col;
+		
+		_bit = fontWidth - 1 - length;
+		
+		if (length > 0)
+		{
+			writeMask(GLCD_MASK(_bit + 1, fontWidth - 1), T6963_DATA_WRITE_AND_NONVARIABLE);
+		}
+		
+		return;
+	}
+	
+	if (length < 0)
+	{
+		length = -length;
+		
+		if (_bit + length <= fontWidth)
+		{
+			writeMask(GLCD_MASK(_bit, _bit + length - 1), T6963_DATA_WRITE_AND_NONVARIABLE);
+			
+			if (_bit + length == fontWidth)
+			{
+				_bit = 0;
+				_address--;
+			}
+			else
+			{
+				_bit += length;
+			}
+			
+			return;
+		}
+		
+		if (_bit > 0)
+		{
+			length -= fontWidth - _bit;
+			writeMask(GLCD_MASK(_bit, fontWidth - 1), T6963_DATA_WRITE_AND_DECREMENT);
+			_address--;
+		}
+		
+		col = length / fontWidth;
+		length -= col * fontWidth;
+		
+		if (col > 8)
+		{
+			// auto write only increments, so long runs are written forward from their left end
+			_address -= col - 1;
+			setAddress();
+			writeBlock(data, col);
+			_address--;
+		}
+		else
+		{
+			while (col > 0)
+			{
+				writeByteDec(data);
+				_address--;
+				col--;
+			}
+		}
+		
+		_bit = length;
+		
+		if (length > 0)
+		{
+			setAddress();
+			writeMask(GLCD_MASK(0, length - 1), T6963_DATA_WRITE_AND_NONVARIABLE);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a vertical line
+//
+//	Input	length: line length
+//
+//	Output	none
+//
+//	The controller only steps its address pointer by one byte, so every
+//	pixel costs an address set and a bit set. Vertical lines are left at
+//	that, GLCD_FRAMEBUFFER draws them in ram for sketches that need many
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::vertLine(int16_t length)
+{
+	uint8_t data;
+	
+	data = _color | _bit;
+	
+	if (length > 0)
+	{
+		do
+		{
+			setAddress();
+			writeBit(data);
+			
+			_address += graphWidth;
+			
+			length--;
+		}
+		while (length > 0);
+		
+		return;
+	}
+	
+	if (length < 0)
+	{
+		do
+		{
+			setAddress();
+			writeBit(data);
+			
+			_address -= graphWidth;
+			
+			length++;
+		}
+		while (length < 0);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a diagonal line
+//
+//	Input	dx: change in x
+//			yIsNeg: 1 if y is negative
+//
+//	Output	none
+//
+//	Each pixel is a row away from the last one, so like vertLine() it
+//	costs an address set and a bit set
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::diagLine(int16_t dx, uint8_t yIsNeg)
+{
+	uint8_t data;
+	int16_t dy;
+	
+	data = _color;
+	dy =  graphWidth;
+	
+	if (yIsNeg)
+	{
+		dy = -dy;
+	}
+	
+	if (dx > 0)
+	{
+		do
+		{
+			setAddress();
+			writeBit(data | _bit);
+			
+			if (_bit > 0)
+			{
+				_bit--;
+			}
+			else
+			{
+				_bit = fontWidth - 1;
+				_address++;
+			}
+			
+			_address += dy;
+			
+			dx--;
+		}
+		while (dx > 0);
+		
+		return;
+	}
+	
+	if (dx < 0)
+	{
+		do
+		{
+			setAddress();
+			writeBit(data | _bit);
+			
+			if (_bit < fontWidth - 1)
+			{
+				_bit++;
+			}
+			else
+			{
+				_bit = 0;
+				_address--;
+			}
+			
+			_address += dy;
+			
+			dx++;
+		}
+		while (dx < 0);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a bresenham run-slice line
+//
+//	Input	dx: change in x
+//			dy: change in y
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::bresenLine(int16_t dx, int16_t dy)
+{
+	uint16_t errInc, errDec;
+	int16_t mem, error, step;
+	int8_t incX, incY;
+	
+	mem = graphWidth;
+	incX = 1;
+	incY = 1;
+	
+	if (dx < 0)
+	{
+		dx = -dx;
+		incX = -1;
+	}
+	
+	if (dy < 0)
+	{
+		dy = -dy;
+		incY = -1;
+		mem = -mem;
+	}
+	
+	if (dx > dy)
+	{
+		error = (dx % dy);
+		
+		errInc = error * 2;
+		errDec = dy * 2;
+		
+		step = (dx / dy) * incX;
+		
+		error -= ((step & 0x01) == 0) ? errDec : dy;
+		
+		horizLine(step / 2 + (errInc == 0 && (step & 0x01) == 0 ? 0 : incX));
+		_address += mem;
+		
+		dy -= 1;
+		
+		while (dy > 0)
+		{
+			error += errInc;
+			
+			if (error > 0)
+			{
+				error -= errDec;
+				horizLine(step + incX);
+			}
+			else
+			{
+				horizLine(step);
+			}
+			
+			_address += mem;
+			
+			dy--;
+		}
+		
+		horizLine(step / 2);
+	}
+	else
+	{
+		error = (dy % dx);
+		
+		errInc = error * 2;
+		errDec = dx * 2;
+		
+		step = (dy / dx) * incY;
+		
+		error -= ((step & 0x01) == 0) ? errDec : dx;
+		
+		vertLine(step / 2 - (errInc == 0 && (step & 0x01) == 0 ? incY : 0));
+		horizLine(incX);
+		_address += mem;
+		
+		dx -= 1;
+		
+		while (dx > 0)
+		{
+			error += errInc;
+			
+			if (error > 0)
+			{
+				error -= errDec;
+				vertLine(step);
+			}
+			else
+			{
+				vertLine(step - incY);
+			}
+			
+			horizLine(incX);
+			_address += mem;
+			
+			dx--;
+		}
+		
+		vertLine(step / 2);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a span of pixels on one row
+//
+//	Input	x0: left pixel
+//			x1: right pixel
+//			y: row
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::span(uint8_t x0, uint8_t x1, uint8_t y)
+{
+	uint8_t col0, col1, first, last;
+	
+	col0 = GLCD_COLUMN(x0);
+	col1 = GLCD_COLUMN(x1);
+	
+	first = GLCD_MASK(0, GLCD_BIT(x0));
+	last = GLCD_MASK(GLCD_BIT(x1), fontWidth - 1);
+	
+	setPointer(_graph + graphWidth * y + col0);
+	
+	if (col0 == col1)
+	{
+		writeMask(first & last, T6963_DATA_WRITE_AND_NONVARIABLE);
+		return;
+	}
+	
+	if (first != GLCD_MASK(0, fontWidth - 1))
+	{
+		writeMask(first, T6963_DATA_WRITE_AND_INCREMENT);
+		col0++;
+	}
+	
+	if (last == GLCD_MASK(0, fontWidth - 1))
+	{
+		col1++;
+	}
+	
+	writeBlock(_color ? 0xFF : 0, col1 - col0);
+	
+	if (last != GLCD_MASK(0, fontWidth - 1))
+	{
+		writeMask(last, T6963_DATA_WRITE_AND_NONVARIABLE);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Fill a block of pixels
+//
+//	Input	x0, y0: top left corner
+//			x1, y1: bottom right corner
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::fill(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+	// full width rows are contiguous in memory and go out as one block
+	if (x0 == 0 && x1 == graphWidth * fontWidth - 1)
+	{
+		setPointer(_graph + graphWidth * y0);
+		writeBlock(_color ? 0xFF : 0, graphWidth * (y1 - y0 + 1));
+		return;
+	}
+	
+	while (y0 <= y1)
+	{
+		span(x0, x1, y0);
+		y0++;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set the drawing position
+//
+//	Input	x, y: new position, may be outside the screen
+//
+//	Output	none
+//
+//	The memory address only follows while the position is on the screen
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setPen(int16_t x, int16_t y)
+{
+	_lastX = x;
+	_lastY = y;
+	
+	if (x >= 0 && x < screenWidth && y >= 0 && y < screenHeight)
+	{
+		_address = _graph + graphWidth * y + GLCD_COLUMN(x);
+		_bit = GLCD_BIT(x);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Find where a point lies against the clip rectangle
+//
+//	Input	x, y: point
+//
+//	Output	GLCD_CLIP_ bits of the edges it is beyond, 0 inside
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::outCode(int16_t x, int16_t y)
+{
+	uint8_t code;
+	
+	code = 0;
+	
+	if (x < _clipLeft)
+	{
+		code |= GLCD_CLIP_LEFT;
+	}
+	else if (x > _clipRight)
+	{
+		code |= GLCD_CLIP_RIGHT;
+	}
+	
+	if (y < _clipTop)
+	{
+		code |= GLCD_CLIP_TOP;
+	}
+	else if (y > _clipBottom)
+	{
+		code |= GLCD_CLIP_BOTTOM;
+	}
+	
+	return code;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Find where a line crosses a clip edge
+//
+//	Input	a0, a1: ends of the line across the edge
+//			b0, b1: ends of the line along the edge normal
+//			b: position of the edge
+//
+//	Output	position along the edge, rounded to the nearest pixel
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+int16_t GLCD_PANEL::intercept(int16_t a0, int16_t a1, int16_t b0, int16_t b1, int16_t b)
+{
+	int32_t num;
+	int16_t den;
+	
+	num = (int32_t)(a1 - a0) * (b - b0);
+	den = b1 - b0;
+	
+	if (den < 0)
+	{
+		num = -num;
+		den = -den;
+	}
+	
+	num += (num < 0) ? -(den / 2) : den / 2;
+	
+	return a0 + num / den;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a line from the drawing position clipped to the clip rectangle
+//
+//	Input	dx: change in x
+//			dy: change in y
+//
+//	Output	none
+//
+//	Lines leave out their end point so joined lines draw it once, a line cut
+//	by the clip rectangle draws the point where it leaves instead
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::segment(int16_t dx, int16_t dy)
+{
+	int16_t x0, y0, x1, y1, x, y;
+	uint8_t code0, code1, code, cut;
+	
+	x0 = _lastX;
+	y0 = _lastY;
+	x1 = x0 + dx;
+	y1 = y0 + dy;
+	
+	code0 = outCode(x0, y0);
+	code1 = outCode(x1, y1);
+	cut = code1;
+	
+	// Cohen-Sutherland, move an outside end onto the edge it is beyond until both are
+	// inside or both are beyond the same edge
+	while (code0 | code1)
+	{
+		if (code0 & code1)
+		{
+			setPen(_lastX + dx, _lastY + dy);
+			return;
+		}
+		
+		code = code0 ? code0 : code1;
+		
+		if (code & GLCD_CLIP_TOP)
+		{
+			x = intercept(x0, x1, y0, y1, _clipTop);
+			y = _clipTop;
+		}
+		else if (code & GLCD_CLIP_BOTTOM)
+		{
+			x = intercept(x0, x1, y0, y1, _clipBottom);
+			y = _clipBottom;
+		}
+		else if (code & GLCD_CLIP_LEFT)
+		{
+			y = intercept(y0, y1, x0, x1, _clipLeft);
+			x = _clipLeft;
+		}
+		else
+		{
+			y = intercept(y0, y1, x0, x1, _clipRight);
+			x = _clipRight;
+		}
+		
+		if (code == code0)
+		{
+			x0 = x;
+			y0 = y;
+			code0 = outCode(x0, y0);
+		}
+		else
+		{
+			x1 = x;
+			y1 = y;
+			code1 = outCode(x1, y1);
+		}
+	}
+	
+	x = _lastX + dx;
+	y = _lastY + dy;
+	
+	if (x0 != _lastX || y0 != _lastY)
+	{
+		setPen(x0, y0);
+	}
+	
+	dx = x1 - x0;
+	dy = y1 - y0;
+	
+	if (dy == 0)
+	{
+		if (dx != 0)
+		{
+			horizLine(dx);
+		}
+	}
+	else if (dx == 0)
+	{
+		vertLine(dy);
+	}
+	else if (dx == dy || dx == -dy)
+	{
+		diagLine(dx, (dy < 0));
+	}
+	else
+	{
+		bresenLine(dx, dy);
+	}
+	
+	if (cut)
+	{
+		setPen(x1, y1);
+		setAddress();
+		writeBit(_color | _bit);
+		
+		setPen(x, y);
+	}
+	else
+	{
+		_lastX = x;
+		_lastY = y;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a span of pixels on one row clipped to the clip rectangle
+//
+//	Input	x0: left pixel
+//			x1: right pixel
+//			y: row
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::clipSpan(int16_t x0, int16_t x1, int16_t y)
+{
+	if (y < _clipTop || y > _clipBottom)
+	{
+		return;
+	}
+	
+	x0 = GLCD_MAX(x0, _clipLeft);
+	x1 = GLCD_MIN(x1, _clipRight);
+	
+	if (x0 <= x1)
+	{
+		span(x0, x1, y);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Fill a block of pixels clipped to the clip rectangle
+//
+//	Input	x0, y0: one corner
+//			x1, y1: opposite corner
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::clipFill(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	int16_t tmp;
+	
+	if (x0 > x1)
+	{
+		tmp = x0;
+		x0 = x1;
+		x1 = tmp;
+	}
+	
+	if (y0 > y1)
+	{
+		tmp = y0;
+		y0 = y1;
+		y1 = tmp;
+	}
+	
+	x0 = GLCD_MAX(x0, _clipLeft);
+	y0 = GLCD_MAX(y0, _clipTop);
+	x1 = GLCD_MIN(x1, _clipRight);
+	y1 = GLCD_MIN(y1, _clipBottom);
+	
+	if (x0 <= x1 && y0 <= y1)
+	{
+		fill(x0, y0, x1, y1);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Sine of 0 - 90 degrees scaled by 255
+//
+//-------------------------------------------------------------------------------------------------
+
+const uint8_t curveSine[91] PROGMEM =
+{
+	  0,   4,   9,  13,  18,  22,  27,  31,  35,  40,
+	 44,  49,  53,  57,  62,  66,  70,  75,  79,  83,
+	 87,  91,  96, 100, 104, 108, 112, 116, 120, 124,
+	127, 131, 135, 139, 143, 146, 150, 153, 157, 160,
+	164, 167, 171, 174, 177, 180, 183, 186, 190, 192,
+	195, 198, 201, 204, 206, 209, 211, 214, 216, 219,
+	221, 223, 225, 227, 229, 231, 233, 235, 236, 238,
+	240, 241, 243, 244, 245, 246, 247, 248, 249, 250,
+	251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+	255
+};
+
+//-------------------------------------------------------------------------------------------------
+//
+// Find the direction of an angle
+//
+//	Input	angle: degrees counter clockwise from 3 o'clock
+//			*x, *y: direction scaled by 255 (y up)
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::direction(int16_t angle, int16_t *x, int16_t *y)
+{
+	angle %= 360;
+	
+	if (angle < 0)
+	{
+		angle += 360;
+	}
+	
+	if (angle <= 90)
+	{
+		*x = pgm_read_byte(&curveSine[90 - angle]);
+		*y = pgm_read_byte(&curveSine[angle]);
+	}
+	else if (angle <= 180)
+	{
+		*x = -pgm_read_byte(&curveSine[angle - 90]);
+		*y = pgm_read_byte(&curveSine[180 - angle]);
+	}
+	else if (angle <= 270)
+	{
+		*x = -pgm_read_byte(&curveSine[270 - angle]);
+		*y = -pgm_read_byte(&curveSine[angle - 180]);
+	}
+	else
+	{
+		*x = pgm_read_byte(&curveSine[angle - 270]);
+		*y = -pgm_read_byte(&curveSine[360 - angle]);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set up the ends of an arc
+//
+//	Input	*sector: sector to fill in
+//			start: first angle in degrees counter clockwise from 3 o'clock
+//			end: last angle, a full turn or more from start is the whole curve
+//
+//	Output	0 for the whole curve, 1 for a part of it
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::makeSector(Sector *sector, int16_t start, int16_t end)
+{
+	int16_t sweep;
+	
+	if (end - start >= 360 || start - end >= 360)
+	{
+		return 0;
+	}
+	
+	sweep = (end - start) % 360;
+	
+	if (sweep < 0)
+	{
+		sweep += 360;
+	}
+	
+	direction(start, &sector->startX, &sector->startY);
+	direction(end, &sector->endX, &sector->endY);
+	sector->wide = (sweep > 180);
+	
+	return 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Narrow a run of pixels to one side of a line through the drawing position
+//
+//	Input	c, k: pixels with c * x >= k are kept
+//			*x0, *x1: run of pixels to narrow
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::halfPlane(int16_t c, int32_t k, int16_t *x0, int16_t *x1)
+{
+	int32_t bound;
+	
+	if (c == 0)
+	{
+		if (k > 0)
+		{
+			*x0 = *x1 + 1;
+		}
+		
+		return;
+	}
+	
+	// floor(k / c) for c < 0, ceil(k / c) for c > 0
+	if (c < 0)
+	{
+		c = -c;
+		k = -k;
+		
+		bound = (k >= 0) ? k / c : -((c - 1 - k) / c);
+		
+		if (bound < *x1)
+		{
+			*x1 = GLCD_MAX(bound, *x0 - 1);
+		}
+	}
+	else
+	{
+		bound = (k >= 0) ? (k + c - 1) / c : -(-k / c);
+		
+		if (bound > *x0)
+		{
+			*x0 = GLCD_MIN(bound, *x1 + 1);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a run of curve pixels cut to an arc and the clip rectangle
+//
+//	Input	x0, x1: run of pixels from the centre
+//			y: row from the centre
+//			*sector: ends of the arc, 0 for the whole curve
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::curveSpan(int16_t x0, int16_t x1, int16_t y, const Sector *sector)
+{
+	int16_t lo, hi;
+	
+	if (sector)
+	{
+		lo = x0;
+		hi = x1;
+		
+		// left of the start direction and right of the end direction (y is down the screen)
+		halfPlane(-sector->startY, (int32_t)sector->startX * y, &x0, &x1);
+		halfPlane(sector->endY, -(int32_t)sector->endX * y, &lo, &hi);
+		
+		if (!sector->wide)
+		{
+			x0 = GLCD_MAX(x0, lo);
+			x1 = GLCD_MIN(x1, hi);
+		}
+		else if (x0 > x1)
+		{
+			x0 = lo;
+			x1 = hi;
+		}
+		else if (lo <= hi)
+		{
+			// more than a half turn keeps either side, two runs unless they meet
+			if (lo > x1 + 1 || hi < x0 - 1)
+			{
+				clipSpan(_lastX + lo, _lastX + hi, _lastY + y);
+			}
+			else
+			{
+				x0 = GLCD_MIN(x0, lo);
+				x1 = GLCD_MAX(x1, hi);
+			}
+		}
+	}
+	
+	if (x0 <= x1)
+	{
+		clipSpan(_lastX + x0, _lastX + x1, _lastY + y);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a row of an ellipse above and below the centre
+//
+//	Input	x0, x1: outline pixels right of the centre
+//			y: row from the centre
+//			fill: 1 to fill between the two sides
+//			*sector: ends of the arc, 0 for the whole curve
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::curveRow(int16_t x0, int16_t x1, int16_t y, uint8_t fill, const Sector *sector)
+{
+	if (fill || x0 == 0)
+	{
+		curveSpan(-x1, x1, -y, sector);
+		
+		if (y != 0)
+		{
+			curveSpan(-x1, x1, y, sector);
+		}
+		
+		return;
+	}
+	
+	curveSpan(-x1, -x0, -y, sector);
+	curveSpan(x0, x1, -y, sector);
+	
+	if (y != 0)
+	{
+		curveSpan(-x1, -x0, y, sector);
+		curveSpan(x0, x1, y, sector);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw an ellipse around the drawing position
+//
+//	Input	xRadius, yRadius: radii
+//			fill: 1 to fill it
+//			*sector: ends of the arc, 0 for the whole curve
+//
+//	Output	none
+//
+//	Walks the quarter from the top to the right with the midpoint test from
+//	the old Draw class and sends each row of it as byte spans
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::curve(uint8_t xRadius, uint8_t yRadius, uint8_t fill, const Sector *sector)
+{
+	int16_t dx, dy, first;
+	int32_t a2, b2, crit1, crit2, crit3, t, dxt, dyt, d2xt, d2yt;
+	
+	if (outCode(_lastX - xRadius, _lastY - yRadius) & outCode(_lastX + xRadius, _lastY + yRadius))
+	{
+		return;
+	}
+	
+	dx = 0;
+	dy = yRadius;
+	first = 0;
+	
+	a2 = (int32_t)xRadius * xRadius;
+	b2 = (int32_t)yRadius * yRadius;
+	
+	crit1 = -(a2 / 4 + xRadius % 2 + b2);
+	crit2 = -(b2 / 4 + yRadius % 2 + a2);
+	crit3 = -(b2 / 4 + yRadius % 2);
+	
+	t = -a2 * dy;
+	dxt = 0;
+	dyt = -2 * a2 * dy;
+	
+	d2xt = 2 * b2;
+	d2yt = 2 * a2;
+	
+	while (dy >= 0 && dx <= xRadius)
+	{
+		if (t + b2 * dx <= crit1 || t + a2 * dy <= crit3)
+		{
+			dx++;
+			dxt += d2xt;
+			t += dxt;
+		}
+		else
+		{
+			curveRow(first, dx, dy, fill, sector);
+			
+			if (t - a2 * dy <= crit2)
+			{
+				dx++;
+				dxt += d2xt;
+				t += dxt;
+			}
+			
+			dy--;
+			dyt += d2yt;
+			t += dyt;
+			
+			first = dx;
+		}
+	}
+	
+	if (dy >= 0)
+	{
+		curveRow(first, xRadius, dy, fill, sector);
+	}
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Basic Drawing Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Clear graphic memory
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::clearGraph(void)
+{
+#ifdef GLCD_RECORD
+	recordOp(GLCD_OP_CLEAR_GRAPH, 0);
+#endif
+
+	setPointer(_graph);
+	writeBlock(0, graphArea);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set the color to draw
+//
+//	Input	color: the color (1 = black; 0 = white)
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setColor(uint8_t color)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_COLOR, 1))
+	{
+		recordByte(color);
+	}
+#endif
+
+	_color = (color > 0) ? T6963_BIT_SET : T6963_BIT_RESET;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Limit drawing to a rectangle
+//
+//	Input	x, y: top left corner
+//			w, h: size in pixels
+//
+//	Output	none
+//
+//	Lines, rectangles and fills are cut to the rectangle, anything wholly
+//	outside it is dropped before it reaches the bus
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::setClip(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_CLIP, 4))
+	{
+		recordByte(x);
+		recordByte(y);
+		recordByte(w);
+		recordByte(h);
+	}
+#endif
+
+	if (x < screenWidth && y < screenHeight && w > 0 && h > 0)
+	{
+		_clipLeft = x;
+		_clipTop = y;
+		_clipRight = GLCD_MIN(x + w, screenWidth) - 1;
+		_clipBottom = GLCD_MIN(y + h, screenHeight) - 1;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Allow drawing on the whole screen
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::clearClip(void)
+{
+#ifdef GLCD_RECORD
+	recordOp(GLCD_OP_CLEAR_CLIP, 0);
+#endif
+
+	_clipLeft = 0;
+	_clipTop = 0;
+	_clipRight = screenWidth - 1;
+	_clipBottom = screenHeight - 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Move to a relative point in graphic memory
+//
+//	Input	dx: change in x
+//			dy: change in y
+//
+//	Output	none
+//
+//	The point may be off the screen, lines drawn from there are clipped
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::move(int16_t dx, int16_t dy)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_MOVE, 4))
+	{
+		recordWord(dx);
+		recordWord(dy);
+	}
+#endif
+
+	setPen(_lastX + dx, _lastY + dy);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Move to a point in graphic memory
+//
+//	Input	x: new x
+//			y: new y
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::moveTo(uint8_t x, uint8_t y)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_MOVE_TO, 2))
+	{
+		recordByte(x);
+		recordByte(y);
+	}
+#endif
+
+	setPen(x, y);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a line to a relative point in graphic memory
+//
+//	Input	dx: change in x
+//			dy: change in y
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::line(int16_t dx, int16_t dy)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_LINE, 4))
+	{
+		recordWord(dx);
+		recordWord(dy);
+	}
+#endif
+
+	segment(dx, dy);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a line to a point in graphic memory
+//
+//	Input	x: new x
+//			y: new y
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::lineTo(uint8_t x, uint8_t y)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_LINE_TO, 2))
+	{
+		recordByte(x);
+		recordByte(y);
+	}
+#endif
+
+	segment(x - _lastX, y - _lastY);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a rectangle relative to a point in graphic memory
+//
+//	Input	dx: width
+//			dy: height
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::rect(int16_t dx, int16_t dy)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_RECT, 4))
+	{
+		recordWord(dx);
+		recordWord(dy);
+	}
+#endif
+
+	if (outCode(_lastX, _lastY) & outCode(_lastX + dx, _lastY + dy))
+	{
+		return;
+	}
+	
+	if (dy == 0 || dx == 0)
+	{
+		segment(dx, dy);
+		setPen(_lastX - dx, _lastY - dy);
+	}
+	else
+	{
+		segment(dx, 0);
+		segment(0, dy);
+		segment(-dx, 0);
+		segment(0, -dy);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a rectangle relative to a point in graphic memory with diagonal corners
+//
+//	Input	dx: width
+//			dy: height
+//			diag: diagonal corner size
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::rect(int16_t dx, int16_t dy, uint8_t diag)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_RECT_DIAG, 5))
+	{
+		recordWord(dx);
+		recordWord(dy);
+		recordByte(diag);
+	}
+#endif
+
+	if (outCode(_lastX + 1, _lastY) & outCode(_lastX + 1 + dx, _lastY + dy))
+	{
+		return;
+	}
+	
+	if (dx >= diag * 2 && dy >= diag * 2)
+	{
+		setPen(_lastX + diag + 1, _lastY);
+		
+		segment(dx - diag * 2, 0);
+		segment(diag, diag);
+		
+		segment(0, dy - diag * 2);
+		segment(-diag, diag);
+		
+		segment(diag * 2 - dx, 0);
+		segment(-diag, -diag);
+		
+		segment(0, diag * 2 - dy);
+		segment(diag, -diag);
+		
+		setPen(_lastX - diag, _lastY);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a rectangle to a point in graphic memory
+//
+//	Input	x: new x
+//			y: new y
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::rectTo(uint8_t x, uint8_t y)
+{
+	rect(x - _lastX, y - _lastY);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Fill a rectangle relative to a point in graphic memory
+//
+//	Input	dx: width
+//			dy: height
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::fillRect(int16_t dx, int16_t dy)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_FILL_RECT, 4))
+	{
+		recordWord(dx);
+		recordWord(dy);
+	}
+#endif
+
+	clipFill(_lastX, _lastY, _lastX + dx, _lastY + dy);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Fill a rectangle relative to a point in graphic memory with diagonal corners
+//
+//	Input	dx: width
+//			dy: height
+//			diag: diagonal corner size
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::fillRect(int16_t dx, int16_t dy, uint8_t diag)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_FILL_RECT_DIAG, 5))
+	{
+		recordWord(dx);
+		recordWord(dy);
+		recordByte(diag);
+	}
+#endif
+
+	// covers the same pixels as rect(dx, dy, diag)
+	if (dx >= diag * 2 && dy >= diag * 2)
+	{
+		int16_t row, last, inset;
+		
+		// only the rows inside the clip rectangle
+		row = GLCD_MAX(0, _clipTop - _lastY);
+		last = GLCD_MIN(dy, _clipBottom - _lastY);
+		
+		for (; row <= last; row++)
+		{
+			if (row < diag)
+			{
+				inset = diag - row;
+			}
+			else if (row > dy - diag)
+			{
+				inset = row - (dy - diag);
+			}
+			else
+			{
+				inset = 0;
+			}
+			
+			clipSpan(_lastX + 1 + inset, _lastX + 1 + dx - inset, _lastY + row);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Fill a rectangle to a point in graphic memory
+//
+//	Input	x: opposite corner x
+//			y: opposite corner y
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::fillRectTo(uint8_t x, uint8_t y)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_FILL_RECT_TO, 2))
+	{
+		recordByte(x);
+		recordByte(y);
+	}
+#endif
+
+	clipFill(_lastX, _lastY, x, y);
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Curve Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a circle around the drawing position
+//
+//	Input	radius: radius
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::circle(uint8_t radius)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_ELLIPSE, 2))
+	{
+		recordByte(radius);
+		recordByte(radius);
+	}
+#endif
+
+	curve(radius, radius, 0, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw an ellipse around the drawing position
+//
+//	Input	xRadius: horizontal radius
+//			yRadius: vertical radius
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::ellipse(uint8_t xRadius, uint8_t yRadius)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_ELLIPSE, 2))
+	{
+		recordByte(xRadius);
+		recordByte(yRadius);
+	}
+#endif
+
+	curve(xRadius, yRadius, 0, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw an arc around the drawing position
+//
+//	Input	radius: radius
+//			start: first angle in degrees counter clockwise from 3 o'clock
+//			end: last angle, the arc runs counter clockwise from start
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::arc(uint8_t radius, int16_t start, int16_t end)
+{
+	Sector sector;
+	
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_ARC, 5))
+	{
+		recordByte(radius);
+		recordWord(start);
+		recordWord(end);
+	}
+#endif
+
+	if (start == end)
+	{
+		return;
+	}
+	
+	curve(radius, radius, 0, makeSector(&sector, start, end) ? &sector : 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Fill a circle around the drawing position
+//
+//	Input	radius: radius
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::fillCircle(uint8_t radius)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_FILL_ELLIPSE, 2))
+	{
+		recordByte(radius);
+		recordByte(radius);
+	}
+#endif
+
+	curve(radius, radius, 1, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Fill an ellipse around the drawing position
+//
+//	Input	xRadius: horizontal radius
+//			yRadius: vertical radius
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::fillEllipse(uint8_t xRadius, uint8_t yRadius)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_FILL_ELLIPSE, 2))
+	{
+		recordByte(xRadius);
+		recordByte(yRadius);
+	}
+#endif
+
+	curve(xRadius, yRadius, 1, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Fill a pie slice around the drawing position
+//
+//	Input	radius: radius
+//			start: first angle in degrees counter clockwise from 3 o'clock
+//			end: last angle, the slice runs counter clockwise from start
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::fillArc(uint8_t radius, int16_t start, int16_t end)
+{
+	Sector sector;
+	
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_FILL_ARC, 5))
+	{
+		recordByte(radius);
+		recordWord(start);
+		recordWord(end);
+	}
+#endif
+
+	if (start == end)
+	{
+		return;
+	}
+	
+	curve(radius, radius, 1, makeSector(&sector, start, end) ? &sector : 0);
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Polygon Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Add an edge to the edge table
+//
+//	Input	x0, y0: one end
+//			x1, y1: other end
+//
+//	Output	none
+//
+//	The table grows on the heap as vertices come in, an edge that does not
+//	fit in the free memory marks the table full and fillPoly() draws nothing
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::addEdge(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	Edge *edge;
+	
+	// rows are sampled at their top, so flat edges never cross one
+	if (y0 == y1)
+	{
+		return;
+	}
+	
+	if (_edgeFull)
+	{
+		return;
+	}
+	
+	if (_edgeCount == _edgeSize)
+	{
+		edge = (Edge*)realloc(_edges, (_edgeSize + GLCD_EDGE_CHUNK) * sizeof(Edge));
+		
+		if (!edge)
+		{
+			_edgeFull = 1;
+			return;
+		}
+		
+		_edges = edge;
+		_edgeSize += GLCD_EDGE_CHUNK;
+	}
+	
+	edge = &_edges[_edgeCount++];
+	
+	if (y0 < y1)
+	{
+		edge->top = y0;
+		edge->bottom = y1;
+		edge->x = x0;
+		edge->step = x1 - x0;
+	}
+	else
+	{
+		edge->top = y1;
+		edge->bottom = y0;
+		edge->x = x1;
+		edge->step = x0 - x1;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Start a polygon
+//
+//	Input	none
+//
+//	Output	none
+//
+//	Follow with vertex() for each corner and fillPoly() to draw it
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::beginPoly(void)
+{
+#ifdef GLCD_RECORD
+	recordOp(GLCD_OP_BEGIN_POLY, 0);
+#endif
+
+	_edgeCount = 0;
+	_edgeFull = 0;
+	_polyOpen = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Add a corner to the polygon
+//
+//	Input	x, y: corner, may be outside the screen
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::vertex(int16_t x, int16_t y)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_VERTEX, 4))
+	{
+		recordWord(x);
+		recordWord(y);
+	}
+#endif
+
+	if (_polyOpen)
+	{
+		addEdge(_polyX, _polyY, x, y);
+	}
+	else
+	{
+		_polyFirstX = x;
+		_polyFirstY = y;
+		_polyOpen = 1;
+	}
+	
+	_polyX = x;
+	_polyY = y;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Close the polygon and fill it
+//
+//	Input	none
+//
+//	Output	none
+//
+//	Pixels inside by the even odd rule are filled a row at a time as byte
+//	spans, the right and bottom edges are left out so polygons that share
+//	an edge do not overlap. Nothing is drawn when the edge table ran out of
+//	memory, like endRecord() when the display list filled up
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::fillPoly(void)
+{
+	Edge edge, *a, *b;
+	int16_t y, last, next, left, right, top, bottom, active, *link;
+	uint16_t count, index;
+	int32_t q;
+	
+#ifdef GLCD_RECORD
+	recordOp(GLCD_OP_FILL_POLY, 0);
+#endif
+
+	if (!_polyOpen)
+	{
+		return;
+	}
+	
+	addEdge(_polyX, _polyY, _polyFirstX, _polyFirstY);
+	_polyOpen = 0;
+	
+	// a table with edges left out would fill the wrong pixels
+	if (_edgeCount == 0 || _edgeFull)
+	{
+		free(_edges);
+		_edges = 0;
+		_edgeSize = 0;
+		_edgeCount = 0;
+		_edgeFull = 0;
+		return;
+	}
+	
+	// sort the edge table by first row and find the bounding box
+	left = right = _edges[0].x;
+	top = _edges[0].top;
+	bottom = _edges[0].bottom;
+	
+	for (count = 0; count < _edgeCount; count++)
+	{
+		edge = _edges[count];
+		
+		for (index = count; index > 0 && _edges[index - 1].top > edge.top; index--)
+		{
+			_edges[index] = _edges[index - 1];
+		}
+		
+		_edges[index] = edge;
+		
+		left = GLCD_MIN(left, GLCD_MIN(edge.x, edge.x + edge.step));
+		right = GLCD_MAX(right, GLCD_MAX(edge.x, edge.x + edge.step));
+		top = GLCD_MIN(top, edge.top);
+		bottom = GLCD_MAX(bottom, edge.bottom);
+	}
+	
+	if (outCode(left, top) & outCode(right, bottom - 1))
+	{
+		free(_edges);
+		_edges = 0;
+		_edgeSize = 0;
+		_edgeCount = 0;
+		return;
+	}
+	
+	y = GLCD_MAX(top, _clipTop);
+	last = GLCD_MIN(bottom - 1, _clipBottom);
+	
+	active = -1;
+	index = 0;
+	
+	for (; y <= last; y++)
+	{
+		// move the edges starting on this row (or above the clip rectangle) to the active list
+		while (index < _edgeCount && _edges[index].top <= y)
+		{
+			a = &_edges[index];
+			
+			if (a->bottom > y)
+			{
+				// x where the edge crosses the row, rounded up, and the remainder
+				a->dy = a->bottom - a->top;
+				q = (int32_t)a->x * a->dy + (int32_t)(y - a->top) * a->step;
+				a->x = (q >= 0) ? (q + a->dy - 1) / a->dy : -(-q / a->dy);
+				a->error = (int32_t)a->x * a->dy - q;
+				a->rem = a->step % a->dy;
+				a->step /= a->dy;
+				
+				a->next = active;
+				active = index;
+			}
+			
+			index++;
+		}
+		
+		// keep the active list in x order, edges only swap where they cross
+		for (link = &active; *link >= 0; )
+		{
+			a = &_edges[*link];
+			
+			if (a->next >= 0 && _edges[a->next].x < a->x)
+			{
+				next = a->next;
+				a->next = _edges[next].next;
+				_edges[next].next = *link;
+				*link = next;
+				link = &active;
+			}
+			else
+			{
+				link = &a->next;
+			}
+		}
+		
+		// fill between pairs of edges
+		for (next = active; next >= 0; next = b->next)
+		{
+			a = &_edges[next];
+			
+			if (a->next < 0)
+			{
+				break;
+			}
+			
+			b = &_edges[a->next];
+			
+			if (a->x < b->x)
+			{
+				clipSpan(a->x, b->x - 1, y);
+			}
+		}
+		
+		// step the edges to the next row and drop the ones that end
+		for (link = &active; *link >= 0; )
+		{
+			a = &_edges[*link];
+			
+			if (a->bottom <= y + 1)
+			{
+				*link = a->next;
+				continue;
+			}
+			
+			a->x += a->step;
+			a->error -= a->rem;
+			
+			if (a->error < 0)
+			{
+				a->x++;
+				a->error += a->dy;
+			}
+			else if (a->error >= a->dy)
+			{
+				a->x--;
+				a->error -= a->dy;
+			}
+			
+			link = &a->next;
+		}
+	}
+	
+	free(_edges);
+	_edges = 0;
+	_edgeSize = 0;
+	_edgeCount = 0;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Display List Functions
+//
+//*************************************************************************************************
+
+#ifdef GLCD_RECORD
+//-------------------------------------------------------------------------------------------------
+//
+// Start copying drawing calls into a display list
+//
+//	Input	*buffer: ram for the list
+//			size: size of the buffer
+//
+//	Output	none
+//
+//	The calls still draw while they are recorded. Bitmaps, the console,
+//	CG ram and text written with a length are left out of the list
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::record(uint8_t *buffer, uint16_t size)
+{
+	_list = (size > 0) ? buffer : 0;
+	_listSize = size;
+	_listLength = 0;
+	_listFull = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Stop recording and end the display list
+//
+//	Input	none
+//
+//	Output	length of the list in bytes, 0 when it did not fit in the buffer
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint16_t GLCD_PANEL::endRecord(void)
+{
+	if (!_list)
+	{
+		return 0;
+	}
+	
+	// recordOp() always leaves room for this
+	_list[_listLength++] = GLCD_OP_END;
+	_list = 0;
+	
+	return _listFull ? 0 : _listLength;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Add an opcode to the display list being recorded
+//
+//	Input	op: opcode
+//			size: bytes of arguments that will follow
+//
+//	Output	1 when the arguments should be added; 0 when not recording or full
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::recordOp(uint8_t op, uint16_t size)
+{
+	if (!_list || _listFull)
+	{
+		return 0;
+	}
+	
+	// keep a byte for the end of the list
+	if (size + 2 > _listSize - _listLength)
+	{
+		_listFull = 1;
+		return 0;
+	}
+	
+	_list[_listLength++] = op;
+	return 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Add an argument byte to the display list
+//
+//	Input	data: byte
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::recordByte(uint8_t data)
+{
+	_list[_listLength++] = data;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Add an argument word to the display list
+//
+//	Input	data: word, stored low byte first
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::recordWord(int16_t data)
+{
+	_list[_listLength++] = data;
+	_list[_listLength++] = (uint16_t)data >> 8;
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read a byte from a display list
+//
+//	Input	**list: pointer to the list position, moved past the byte
+//			pgm: 1 for a list in program memory
+//
+//	Output	the byte
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+uint8_t GLCD_PANEL::listByte(const uint8_t **list, uint8_t pgm)
+{
+	uint8_t data;
+	
+	data = pgm ? pgm_read_byte(*list) : **list;
+	(*list)++;
+	
+	return data;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read a word from a display list
+//
+//	Input	**list: pointer to the list position, moved past the word
+//			pgm: 1 for a list in program memory
+//
+//	Output	the word
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+int16_t GLCD_PANEL::listWord(const uint8_t **list, uint8_t pgm)
+{
+	uint8_t low;
+	
+	low = listByte(list, pgm);
+	
+	return (int16_t)(low | (listByte(list, pgm) << 8));
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a display list
+//
+//	Input	*list: pointer to the list
+//			pgm: 1 for a list in program memory
+//
+//	Output	none
+//
+//	Fills that line up with the one before on the same rows or columns
+//	are joined and drawn as one, and runs of text stay in one auto write
+//	across the calls that only move the text or drawing position
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::replay(const uint8_t *list, uint8_t pgm)
+{
+	int16_t a, b, x0, y0, x1, y1, fillLeft, fillTop, fillRight, fillBottom;
+	uint8_t op, c, d, code, pending;
+	
+#ifdef GLCD_RECORD
+	uint8_t *recording;
+	
+	// a list played while recording is not copied into the new one
+	recording = _list;
+	_list = 0;
+#endif
+
+	pending = 0;
+	fillLeft = 0;
+	fillTop = 0;
+	fillRight = 0;
+	fillBottom = 0;
+	
+	while ((op = listByte(&list, pgm)) != GLCD_OP_END)
+	{
+		if (op == GLCD_OP_FILL_RECT || op == GLCD_OP_FILL_RECT_TO)
+		{
+			x0 = _lastX;
+			y0 = _lastY;
+			
+			if (op == GLCD_OP_FILL_RECT)
+			{
+				x1 = x0 + listWord(&list, pgm);
+				y1 = y0 + listWord(&list, pgm);
+			}
+			else
+			{
+				x1 = listByte(&list, pgm);
+				y1 = listByte(&list, pgm);
+			}
+			
+			if (x0 > x1)
+			{
+				a = x0;
+				x0 = x1;
+				x1 = a;
+			}
+			
+			if (y0 > y1)
+			{
+				a = y0;
+				y0 = y1;
+				y1 = a;
+			}
+			
+			// side by side on the same rows or stacked on the same columns
+			if (pending && y0 == fillTop && y1 == fillBottom && x0 <= fillRight + 1 && x1 >= fillLeft - 1)
+			{
+				fillLeft = GLCD_MIN(fillLeft, x0);
+				fillRight = GLCD_MAX(fillRight, x1);
+				continue;
+			}
+			
+			if (pending && x0 == fillLeft && x1 == fillRight && y0 <= fillBottom + 1 && y1 >= fillTop - 1)
+			{
+				fillTop = GLCD_MIN(fillTop, y0);
+				fillBottom = GLCD_MAX(fillBottom, y1);
+				continue;
+			}
+			
+			if (pending)
+			{
+				endText();
+				clipFill(fillLeft, fillTop, fillRight, fillBottom);
+			}
+			
+			fillLeft = x0;
+			fillTop = y0;
+			fillRight = x1;
+			fillBottom = y1;
+			pending = 1;
+			continue;
+		}
+		
+		// anything else that draws graphics goes after the waiting fill and ends the text
+		if (op != GLCD_OP_MOVE && op != GLCD_OP_MOVE_TO && op != GLCD_OP_TEXT_MOVE &&
+			op != GLCD_OP_TEXT_TO && op != GLCD_OP_TEXT)
+		{
+			endText();
+			
+			if (pending)
+			{
+				clipFill(fillLeft, fillTop, fillRight, fillBottom);
+				pending = 0;
+			}
+		}
+		
+		switch (op)
+		{
+			case GLCD_OP_COLOR:
+				setColor(listByte(&list, pgm));
+				break;
+				
+			case GLCD_OP_CLIP:
+				a = listByte(&list, pgm);
+				b = listByte(&list, pgm);
+				c = listByte(&list, pgm);
+				d = listByte(&list, pgm);
+				setClip(a, b, c, d);
+				break;
+				
+			case GLCD_OP_CLEAR_CLIP:
+				clearClip();
+				break;
+				
+			case GLCD_OP_CLEAR_GRAPH:
+				clearGraph();
+				break;
+				
+			case GLCD_OP_MOVE:
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				move(a, b);
+				break;
+				
+			case GLCD_OP_MOVE_TO:
+				a = listByte(&list, pgm);
+				b = listByte(&list, pgm);
+				moveTo(a, b);
+				break;
+				
+			case GLCD_OP_LINE:
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				line(a, b);
+				break;
+				
+			case GLCD_OP_LINE_TO:
+				a = listByte(&list, pgm);
+				b = listByte(&list, pgm);
+				lineTo(a, b);
+				break;
+				
+			case GLCD_OP_RECT:
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				rect(a, b);
+				break;
+				
+			case GLCD_OP_RECT_DIAG:
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				rect(a, b, listByte(&list, pgm));
+				break;
+				
+			case GLCD_OP_FILL_RECT_DIAG:
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				fillRect(a, b, listByte(&list, pgm));
+				break;
+				
+			case GLCD_OP_ELLIPSE:
+				c = listByte(&list, pgm);
+				ellipse(c, listByte(&list, pgm));
+				break;
+				
+			case GLCD_OP_FILL_ELLIPSE:
+				c = listByte(&list, pgm);
+				fillEllipse(c, listByte(&list, pgm));
+				break;
+				
+			case GLCD_OP_ARC:
+				c = listByte(&list, pgm);
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				arc(c, a, b);
+				break;
+				
+			case GLCD_OP_FILL_ARC:
+				c = listByte(&list, pgm);
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				fillArc(c, a, b);
+				break;
+				
+			case GLCD_OP_BEGIN_POLY:
+				beginPoly();
+				break;
+				
+			case GLCD_OP_VERTEX:
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				vertex(a, b);
+				break;
+				
+			case GLCD_OP_FILL_POLY:
+				fillPoly();
+				break;
+				
+			case GLCD_OP_CLEAR_TEXT:
+				clearText();
+				break;
+				
+			case GLCD_OP_TEXT_MOVE:
+				a = listWord(&list, pgm);
+				b = listWord(&list, pgm);
+				text(a, b);
+				break;
+				
+			case GLCD_OP_TEXT_TO:
+				c = listByte(&list, pgm);
+				textTo(c, listByte(&list, pgm));
+				break;
+				
+			// like text() without ending the auto write
+			case GLCD_OP_TEXT:
+				while ((code = listByte(&list, pgm)))
+				{
+					if (_text < textEnd)
+					{
+						writeText(_text, GLCD_CharCode(code));
+						_text++;
+					}
+				}
+				
+				break;
+				
+			// an unknown opcode has unknown arguments, nothing after it can be trusted
+			default:
+				list = 0;
+				break;
+		}
+		
+		if (!list)
+		{
+			break;
+		}
+	}
+	
+	endText();
+	
+	if (pending)
+	{
+		clipFill(fillLeft, fillTop, fillRight, fillBottom);
+	}
+	
+#ifdef GLCD_RECORD
+	_list = recording;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a display list from ram
+//
+//	Input	*list: pointer to the list
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::play(const uint8_t *list)
+{
+	replay(list, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a display list from program memory
+//
+//	Input	*list: pointer to the program memory list
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::playPgm(const uint8_t *list)
+{
+	replay(list, 1);
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Bitmap Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a bitmap from program memory
+//
+//	Input	x, y: top left corner
+//			w, h: size of the bitmap in pixels
+//			*bitmap: pointer to program memory bitmap
+//					 (rows of (w + 7) / 8 bytes, most significant bit on the left)
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::drawBitmapPgm(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *bitmap)
+{
+	uint8_t stride, col0, col1, col, first, last, count, bits, data, row;
+	uint16_t buffer;
+	const uint8_t *src;
+	
+	if (x >= screenWidth || y >= screenHeight || w == 0 || h == 0)
+	{
+		return;
+	}
+	
+	stride = (w + 7) / 8;
+	
+	w = GLCD_MIN(w, screenWidth - x);
+	h = GLCD_MIN(h, screenHeight - y);
+	
+	col0 = GLCD_COLUMN(x);
+	col1 = GLCD_COLUMN(x + w - 1);
+	
+	first = GLCD_MASK(0, GLCD_BIT(x));
+	last = GLCD_MASK(GLCD_BIT(x + w - 1), fontWidth - 1);
+	
+	if (col0 == col1)
+	{
+		first &= last;
+	}
+	
+	// whole columns across the full width are contiguous, so the image is a single burst
+	if (first == GLCD_MASK(0, fontWidth - 1) && last == first && col1 - col0 == graphWidth - 1)
+	{
+		setPointer(_graph + graphWidth * y);
+		autoWrite();
+		
+		for (row = 0; row < h; row++)
+		{
+			src = bitmap + stride * row;
+			count = stride;
+			buffer = 0;
+			bits = 0;
+			
+			for (col = 0; col < graphWidth; col++)
+			{
+				writeAuto(shiftColumn(&src, &count, &buffer, &bits));
+			}
+		}
+		
+		autoReset();
+		return;
+	}
+	
+	for (row = 0; row < h; row++)
+	{
+		src = bitmap + stride * row;
+		count = stride;
+		buffer = 0;
+		bits = x - col0 * fontWidth;
+		
+		setPointer(_graph + graphWidth * (y + row) + col0);
+		data = shiftColumn(&src, &count, &buffer, &bits);
+		
+		if (col0 == col1)
+		{
+			writeMask(data, first, T6963_DATA_WRITE_AND_NONVARIABLE);
+			continue;
+		}
+		
+		col = col0;
+		
+		if (first != GLCD_MASK(0, fontWidth - 1))
+		{
+			writeMask(data, first, T6963_DATA_WRITE_AND_INCREMENT);
+			data = shiftColumn(&src, &count, &buffer, &bits);
+			col++;
+		}
+		
+		// whole columns between the edges
+		if (col1 - col > 2)
+		{
+			autoWrite();
+			
+			while (col < col1)
+			{
+				writeAuto(data);
+				data = shiftColumn(&src, &count, &buffer, &bits);
+				col++;
+			}
+			
+			if (last == GLCD_MASK(0, fontWidth - 1))
+			{
+				writeAuto(data);
+				autoReset();
+				continue;
+			}
+			
+			autoReset();
+		}
+		else
+		{
+			while (col < col1)
+			{
+				writeByteInc(data);
+				data = shiftColumn(&src, &count, &buffer, &bits);
+				col++;
+			}
+		}
+		
+		writeMask(data, last, T6963_DATA_WRITE_AND_NONVARIABLE);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw a run length encoded image from program memory
+//
+//	Input	col: left column
+//			y: top row
+//			*image: pointer to program memory image
+//
+//	Output	none
+//
+//	Image format (written by tools/rle_encode.py):
+//		byte 0		width in columns (fontWidth pixels each)
+//		byte 1		height in rows
+//		then runs covering width * height bytes in display memory order
+//			0x00-0x7F	n + 1 literal bytes follow
+//			0x80-0xFF	the next byte repeated (n & 0x7F) + 3 times
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::drawRlePgm(uint8_t col, uint8_t y, const uint8_t *image)
+{
+	uint8_t cols, rows, left, token, count, data;
+	uint16_t size;
+	
+	cols = pgm_read_byte(image++);
+	rows = pgm_read_byte(image++);
+	
+	if (cols == 0 || col + cols > graphWidth || y >= screenHeight)
+	{
+		return;
+	}
+	
+	size = cols * GLCD_MIN(rows, screenHeight - y);
+	left = cols;
+	data = 0;
+	
+	setPointer(_graph + graphWidth * y + col);
+	autoWrite();
+	
+	while (size > 0)
+	{
+		token = pgm_read_byte(image++);
+		
+		if (token & 0x80)
+		{
+			count = (token & 0x7F) + 3;
+			data = pgm_read_byte(image++);
+		}
+		else
+		{
+			count = token + 1;
+		}
+		
+		while (count > 0 && size > 0)
+		{
+			if (!(token & 0x80))
+			{
+				data = pgm_read_byte(image++);
+			}
+			
+			writeAuto(data);
+			count--;
+			size--;
+			left--;
+			
+			// narrower images jump to the next row, full width rows run on
+			if (left == 0)
+			{
+				left = cols;
+				
+				if (cols < graphWidth && size > 0)
+				{
+					autoReset();
+					setPointer(_pointer + graphWidth - cols);
+					autoWrite();
+				}
+			}
+		}
+	}
+	
+	autoReset();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Copy a region of the screen to another place on the screen
+//
+//	Input	srcX, srcY: top left corner of the region
+//			w, h: size of the region in pixels
+//			dstX, dstY: new top left corner
+//
+//	Output	none
+//
+//	Each row is read into a buffer with auto read before it is written, and
+//	rows are copied bottom up when moving down, so overlapping regions work
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::copyRegion(uint8_t srcX, uint8_t srcY, uint8_t w, uint8_t h, uint8_t dstX, uint8_t dstY)
+{
+	uint8_t buffer[graphWidth];
+	uint8_t src0, size, col0, col1, col, first, last, data, row, y, start, shift, index;
+	int16_t pixel;
+	
+	if (srcX >= screenWidth || srcY >= screenHeight || dstX >= screenWidth || dstY >= screenHeight || w == 0 || h == 0)
+	{
+		return;
+	}
+	
+	w = GLCD_MIN(w, screenWidth - GLCD_MAX(srcX, dstX));
+	h = GLCD_MIN(h, screenHeight - GLCD_MAX(srcY, dstY));
+	
+	src0 = GLCD_COLUMN(srcX);
+	size = GLCD_COLUMN(srcX + w - 1) - src0 + 1;
+	
+	col0 = GLCD_COLUMN(dstX);
+	col1 = GLCD_COLUMN(dstX + w - 1);
+	
+	first = GLCD_MASK(0, GLCD_BIT(dstX));
+	last = GLCD_MASK(GLCD_BIT(dstX + w - 1), fontWidth - 1);
+	
+	if (col0 == col1)
+	{
+		first &= last;
+	}
+	
+	// first pixel of the source buffer that lands in the first destination column, it is less
+	// than a column either side of buffer[0] and the same for every row
+	pixel = col0 * fontWidth - dstX + srcX - src0 * fontWidth;
+	
+	if (pixel < 0)
+	{
+		start = 0;
+		shift = pixel + fontWidth;
+	}
+	else
+	{
+		start = 1;
+		shift = pixel;
+	}
+	
+	for (row = 0; row < h; row++)
+	{
+		y = (dstY > srcY) ? h - 1 - row : row;
+		
+		readRow(buffer, srcY + y, src0, size);
+		
+		index = start;
+		
+		setPointer(_graph + graphWidth * (dstY + y) + col0);
+		data = copyColumn(buffer, size, index, shift);
+		
+		if (col0 == col1)
+		{
+			writeMask(data, first, T6963_DATA_WRITE_AND_NONVARIABLE);
+			continue;
+		}
+		
+		col = col0;
+		
+		if (first != GLCD_MASK(0, fontWidth - 1))
+		{
+			writeMask(data, first, T6963_DATA_WRITE_AND_INCREMENT);
+			index++;
+			data = copyColumn(buffer, size, index, shift);
+			col++;
+		}
+		
+		// whole columns between the edges
+		if (col1 - col > 2)
+		{
+			autoWrite();
+			
+			while (col < col1)
+			{
+				writeAuto(data);
+				index++;
+				data = copyColumn(buffer, size, index, shift);
+				col++;
+			}
+			
+			if (last == GLCD_MASK(0, fontWidth - 1))
+			{
+				writeAuto(data);
+				autoReset();
+				continue;
+			}
+			
+			autoReset();
+		}
+		else
+		{
+			while (col < col1)
+			{
+				writeByteInc(data);
+				index++;
+				data = copyColumn(buffer, size, index, shift);
+				col++;
+			}
+		}
+		
+		writeMask(data, last, T6963_DATA_WRITE_AND_NONVARIABLE);
+	}
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Basic Text Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write a character code to the text area
+//
+//	Input	address: text address
+//			code: character code
+//
+//	Output	none
+//
+//	Consecutive addresses share one auto write, call endText() when done
+//	With GLCD_TEXT_SHADOW unchanged cells are skipped, short gaps between
+//	changed cells are rewritten from the shadow to save the address set
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeText(uint16_t address, uint8_t code)
+{
+#ifdef GLCD_TEXT_SHADOW
+	// the console's second copy of the text area is not shadowed
+	if (address < textEnd)
+	{
+		if (_shadow[address - textStart] == code)
+		{
+			return;
+		}
+		
+		_shadow[address - textStart] = code;
+		
+		if (_auto && address > _pointer && address - _pointer <= GLCD_TEXT_GAP)
+		{
+			while (_pointer < address)
+			{
+				writeAuto(_shadow[_pointer - textStart]);
+			}
+		}
+	}
+#endif
+
+	if (!_auto || address != _pointer)
+	{
+		endText();
+		setPointer(address);
+		autoWrite();
+		_auto = 1;
+	}
+	
+	writeAuto(code);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write a character code to the text area going backward
+//
+//	Input	address: text address
+//			code: character code
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::writeTextDec(uint16_t address, uint8_t code)
+{
+#ifdef GLCD_TEXT_SHADOW
+	if (_shadow[address - textStart] == code)
+	{
+		return;
+	}
+	
+	_shadow[address - textStart] = code;
+#endif
+
+	endText();
+	setPointer(address);
+	writeByteDec(code);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Finish writing to the text area
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::endText(void)
+{
+	if (_auto)
+	{
+		autoReset();
+		_auto = 0;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Clear all text
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::clearText(void)
+{
+#ifdef GLCD_TEXT_SHADOW
+	uint16_t address;
+	
+	for (address = textStart; address < textEnd; address++)
+	{
+		writeText(address, 0);
+	}
+	
+	endText();
+#else
+	setPointer(textStart);
+	writeBlock(0, textArea);
+#endif
+
+#ifdef GLCD_RECORD
+	recordOp(GLCD_OP_CLEAR_TEXT, 0);
+#endif
+
+	_text = textStart;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Clear a section of text
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::clearText(int16_t size)
+{
+	uint16_t address, count;
+	
+	size = GLCD_CONSTRAIN(size, textStart - _text, (textEnd - 1) - _text);
+	
+	// auto write only increments, so clear backward from the far end
+	if (size < 0)
+	{
+		_text += size + 1;
+		address = _text;
+		count = -size;
+		_text--;
+	}
+	else
+	{
+		address = _text;
+		count = size;
+		_text += size;
+	}
+	
+#ifdef GLCD_TEXT_SHADOW
+	while (count > 0)
+	{
+		writeText(address, 0);
+		address++;
+		count--;
+	}
+	
+	endText();
+#else
+	setPointer(address);
+	writeBlock(0, count);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set relative text location
+//
+//	Input	col: horizontal location
+//			row: vertical location
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::text(int16_t col, int16_t row)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_TEXT_MOVE, 4))
+	{
+		recordWord(col);
+		recordWord(row);
+	}
+#endif
+
+	_text = GLCD_CONSTRAIN(_text + textWidth * row + col, 0, textEnd - 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Set text location
+//
+//	Input	col: horizontal location
+//			row: vertical location
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::textTo(uint8_t col, uint8_t row)
+{
+#ifdef GLCD_RECORD
+	if (recordOp(GLCD_OP_TEXT_TO, 2))
+	{
+		recordByte(col);
+		recordByte(row);
+	}
+#endif
+
+	_text = GLCD_MIN(textStart + textWidth * row + col, textEnd - 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write a string of text
+//
+//	Input	*string: pointer to string
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::text(char *string)
+{
+#ifdef GLCD_RECORD
+	uint16_t size, count;
+	
+	size = strlen(string) + 1;
+	
+	if (recordOp(GLCD_OP_TEXT, size))
+	{
+		for (count = 0; count < size; count++)
+		{
+			recordByte(string[count]);
+		}
+	}
+#endif
+
+	while (_text < textEnd && *string)
+	{
+		writeText(_text, GLCD_CharCode(*string));
+		string++;
+		_text++;
+	}
+	
+	endText();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write part of a string of text
+//
+//	Input	*string: pointer to string
+//			size: length of string (can be negative to write backward)
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::text(char *string, int16_t size)
+{
+	uint16_t address;
+	
+	address = _text;
+	
+	size = GLCD_CONSTRAIN(size, textStart - _text, (textEnd - 1) - _text);
+	_text += size;
+	
+	while (size > 0 && *string)
+	{
+		writeText(address, GLCD_CharCode(*string));
+		string++;
+		address++;
+		size--;
+	}
+	
+	endText();
+	
+	while (size < 0 && *string)
+	{
+		writeTextDec(address, GLCD_CharCode(*string));
+		string++;
+		address--;
+		size++;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write a string of text from program memory
+//
+//	Input	col: horizontal location
+//			row: vertical location
+//			*string: pointer to program memory string
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::textPgm(prog_char *string)
+{
+	char charCode;
+	
+#ifdef GLCD_RECORD
+	uint16_t size, count;
+	
+	size = strlen_P(string) + 1;
+	
+	if (recordOp(GLCD_OP_TEXT, size))
+	{
+		for (count = 0; count < size; count++)
+		{
+			recordByte(pgm_read_byte(string + count));
+		}
+	}
+#endif
+
+	while (_text < textEnd && (charCode = pgm_read_byte(string)))
+	{
+		writeText(_text, GLCD_CharCode(charCode));
+		string++;
+		_text++;
+	}
+	
+	endText();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write part of a string of text from program memory
+//
+//	Input	*string: pointer to program memory string
+//			size: length of string (can be negative to write backward)
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::textPgm(prog_char *string, int16_t size)
+{
+	uint16_t address;
+	char charCode;
+	
+	address = _text;
+	
+	size = GLCD_CONSTRAIN(size, textStart - _text, (textEnd - 1) - _text);
+	_text += size;
+	
+	while (size > 0 && (charCode = pgm_read_byte(string)))
+	{
+		writeText(address, GLCD_CharCode(charCode));
+		string++;
+		address++;
+		size--;
+	}
+	
+	endText();
+	
+	while (size < 0 && (charCode = pgm_read_byte(string)))
+	{
+		writeTextDec(address, GLCD_CharCode(charCode));
+		string++;
+		address--;
+		size++;
+	}
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Console Functions
+//
+//*************************************************************************************************
+
+#ifdef GLCD_CONSOLE
+//-------------------------------------------------------------------------------------------------
+//
+// Clear the console
+//
+//	Input	none
+//
+//	Output	none
+//
+//	Lines are kept twice in display memory (row r and row r + textHeight)
+//	so the rows shown from the text home address always hold the last
+//	textHeight lines
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::clearConsole(void)
+{
+	clearText();
+	
+	setPointer(textEnd);
+	writeBlock(0, textArea);
+	
+	_console = 0;
+	GLCD_WriteWord(textStart, T6963_SET_TEXT_HOME_ADDRESS);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Add a line of text to the bottom of the console
+//
+//	Input	*string: pointer to string (longer lines wrap)
+//
+//	Output	none
+//
+//	Each line costs two rows of auto write and one text home address write,
+//	the text functions still write to memory from textStart
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::console(char *string)
+{
+	uint16_t row, copy;
+	uint8_t col, pass;
+	char *line;
+	
+	do
+	{
+		row = textStart + textWidth * _console;
+		line = string;
+		
+		// write the copy shown after the scroll first and the other once it is out of sight
+		copy = (_console + 1 < textHeight) ? textArea : 0;
+		
+		for (pass = 0; pass < 2; pass++)
+		{
+			string = line;
+			
+			for (col = 0; col < textWidth; col++)
+			{
+				if (*string)
+				{
+					writeText(row + copy + col, GLCD_CharCode(*string));
+					string++;
+				}
+				else
+				{
+					writeText(row + copy + col, 0);
+				}
+			}
+			
+			endText();
+			
+			if (pass == 0)
+			{
+				_console = (_console + 1) % textHeight;
+				GLCD_WriteWord(textStart + textWidth * _console, T6963_SET_TEXT_HOME_ADDRESS);
+			}
+			
+			copy = textArea - copy;
+		}
+	}
+	while (*string);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Add a line of text from program memory to the bottom of the console
+//
+//	Input	*string: pointer to program memory string (longer lines wrap)
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::consolePgm(prog_char *string)
+{
+	char line[textWidth + 1];
+	uint8_t col;
+	
+	do
+	{
+		for (col = 0; col < textWidth && (line[col] = pgm_read_byte(string)); col++)
+		{
+			string++;
+		}
+		
+		line[col] = 0;
+		console(line);
+	}
+	while (pgm_read_byte(string));
+}
+#endif
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Character Graphic Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Clear character memory
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::clearCG(void)
+{
+	setPointer(cgStart);
+	writeBlock(0, cgSize);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Load character glyphs from program memory
+//
+//	Input	code: first character code (0x80 and up show with the internal rom font)
+//			count: number of glyphs
+//			*glyphs: pointer to program memory glyphs
+//					 (8 rows per glyph top to bottom, fontWidth low bits per row)
+//
+//	Output	none
+//
+//	Text strings show a glyph by using its code as the character (eg "\x80")
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::loadGlyphs(uint8_t code, uint8_t count, const uint8_t *glyphs)
+{
+	uint16_t size;
+	
+	size = GLCD_MIN(count, 256 - code) * 8;
+	
+	if (size == 0)
+	{
+		return;
+	}
+	
+	setPointer(cgStart + code * 8);
+	autoWrite();
+	
+	while (size > 0)
+	{
+		writeAuto(pgm_read_byte(glyphs));
+		glyphs++;
+		size--;
+	}
+	
+	autoReset();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Load the big digit glyphs into character memory
+//
+//	Input	code: first of BIG_DIGIT_GLYPHS character codes to use
+//
+//	Output	none
+//
+//	Every cell gets one glyph per combination of the segments touching it,
+//	so any digit is drawn from the glyphs without any more uploads
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::loadBigDigits(uint8_t code)
+{
+	uint8_t cell, cells, combination, segments, row;
+	
+	if (code > 256 - BIG_DIGIT_GLYPHS)
+	{
+		return;
+	}
+	
+	_bigBase = code;
+	
+	setPointer(cgStart + code * 8);
+	autoWrite();
+	
+	for (cell = 0; cell < BIG_DIGIT_WIDTH * BIG_DIGIT_HEIGHT; cell++)
+	{
+		cells = pgm_read_byte(&bigCells[cell]);
+		combination = 0;
+		
+		do
+		{
+			segments = spreadBits(combination, cells);
+			
+			for (row = 0; row < 8; row++)
+			{
+				writeAuto(bigRow((cell % BIG_DIGIT_WIDTH) * fontWidth, (cell / BIG_DIGIT_WIDTH) * 8 + row, segments));
+			}
+			
+			combination++;
+		}
+		while (spreadBits(combination, cells) != 0);
+	}
+	
+	//Decimal point in the bottom left cell
+	for (row = 0; row < 8; row++)
+	{
+		writeAuto(bigRow(0, (BIG_DIGIT_HEIGHT - 1) * 8 + row, 0x80));
+	}
+	
+	autoReset();
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write big digits at the text position
+//
+//	Input	*string: digits, '-', ' ' and '.' (a decimal point is one cell wide)
+//
+//	Output	none
+//
+//	Needs loadBigDigits() first, the text position moves to the right of the
+//	top row and the digits are cut off at the end of the line
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::bigText(char *string)
+{
+	uint16_t address;
+	uint8_t room, width, row, cell, segments;
+	char *digit;
+	
+	if (_text + (BIG_DIGIT_HEIGHT - 1) * textWidth >= textEnd)
+	{
+		return;
+	}
+	
+	room = textWidth - (_text - textStart) % textWidth;
+	width = 0;
+	
+	for (row = 0; row < BIG_DIGIT_HEIGHT; row++)
+	{
+		address = _text + row * textWidth;
+		width = 0;
+		
+		for (digit = string; *digit; digit++)
+		{
+			if (*digit == '.')
+			{
+				if (width + 1 > room)
+				{
+					break;
+				}
+				
+				writeText(address, row == BIG_DIGIT_HEIGHT - 1 ? _bigBase + BIG_DIGIT_GLYPHS - 1 : 0);
+				address++;
+				width++;
+				continue;
+			}
+			
+			if (width + BIG_DIGIT_WIDTH > room)
+			{
+				break;
+			}
+			
+			segments = 0;
+			
+			if (*digit >= '0' && *digit <= '9')
+			{
+				segments = pgm_read_byte(&bigDigits[*digit - '0']);
+			}
+			else if (*digit == '-')
+			{
+				segments = 0x40;
+			}
+			
+			for (cell = row * BIG_DIGIT_WIDTH; cell < (row + 1) * BIG_DIGIT_WIDTH; cell++)
+			{
+				writeText(address, _bigBase + pgm_read_byte(&bigOffsets[cell]) + packBits(segments, pgm_read_byte(&bigCells[cell])));
+				address++;
+			}
+			
+			width += BIG_DIGIT_WIDTH;
+		}
+	}
+	
+	endText();
+	
+	_text += width;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//-------------------------------------------------------------------------------------------------
+//
+// T6963 initalization
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+GLCD_TEMPLATE
+void GLCD_PANEL::init(void)
+{
+	Bus::init();
+	_ready = 0;
+	_autoStatus = T6963_STATUS_AUTO_WRITE;
+	
+	//Set text area home address
+	GLCD_WriteWord(textStart, T6963_SET_TEXT_HOME_ADDRESS);
+	
+	//Set text area width in mem
+	GLCD_WriteWord(textWidth, T6963_SET_TEXT_AREA);
+	
+	//Set graphic area home address
+	GLCD_WriteWord(graphStart, T6963_SET_GRAPHIC_HOME_ADDRESS);
+	
+	//Set graphic area width in mem
+	GLCD_WriteWord(graphWidth, T6963_SET_GRAPHIC_AREA);
+	
+	//Set Internal CGRAM address
+	GLCD_WriteWord(cgOffset, T6963_SET_OFFSET_REGISTER);
+	
+	writeCommand(T6963_MODE_SET | T6963_MODE_INTERNAL | T6963_MODE_XOR);
+	writeCommand(T6963_DISPLAY_MODE | (1<<T6963_DISPLAY_TEXT) | (1<<T6963_DISPLAY_GRAPHIC) | (0<<T6963_DISPLAY_CURSOR) | (0<<T6963_DISPLAY_BLINK));
+	
+	//Set the address pointer to a known location
+	GLCD_SetAddress(0);
+	
+	_pointer = 0;
+	_graph = graphStart;
+	_address = 0;
+	_text = 0;
+	_bit = 0;
+	_color = T6963_BIT_SET;
+	_bigBase = 0x80;
+	_showPage = 0;
+	_drawPage = 0;
+	_auto = 0;
+	
+#ifdef GLCD_CONSOLE
+	_console = 0;
+#endif
+
+	clearClip();
+	
+#ifdef GLCD_FRAMEBUFFER
+	//Mark the whole framebuffer dirty so the first flush reaches the graphic area
+	memset(_frame, 0, graphArea);
+	memset(_dirtyLeft, 0, graphHeight);
+	memset(_dirtyRight, graphWidth - 1, graphHeight);
+	_frameStart = 0;
+	_frameRow = 0;
+	_virtual = 0;
+#endif
+
+#ifdef GLCD_TEXT_SHADOW
+	//Make every cell differ so the first clear reaches the whole text area
+	memset(_shadow, 1, textArea);
+#endif
+
+	clearText();
+	clearGraph();
+	flush();
+	clearCG();
+	
+	moveTo(0, 0);
+	
+	_delay_ms(100);
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//*************************************************************************************************
+//	Constructor
+//*************************************************************************************************
+
+GLCD_TEMPLATE
+GLCD_PANEL::T6963Panel()
+{
+	_edges = 0;
+	_edgeSize = 0;
+	_edgeCount = 0;
+	_edgeFull = 0;
+	_polyOpen = 0;
+	
+#ifdef GLCD_RECORD
+	_list = 0;
+#endif
+
+#ifdef GLCD_QUEUE
+	_queueHead = 0;
+	_queueTail = 0;
+	_serving = 0;
+#endif
+}
+
+
+
+
+
+
+//*************************************************************************************************
+//	Local macros
+//*************************************************************************************************
+
+#undef GLCD_TEMPLATE
+#undef GLCD_PANEL
+#undef GLCD_SET_PORT_MODE_READ
+#undef GLCD_SET_PORT_MODE_WRITE
+#undef GLCD_ReadPort
+#undef GLCD_WritePort
+#undef GLCD_CONTROL_RESET
+#undef GLCD_CONTROL_READ_STATUS
+#undef GLCD_CONTROL_READ_DATA
+#undef GLCD_CONTROL_WRITE_COMMAND
+#undef GLCD_CONTROL_WRITE_DATA
+#undef GLCD_WriteWord
+#undef GLCD_SetAddress
+#undef GLCD_MASK
+#undef GLCD_QUEUE_COMMAND
+#undef GLCD_QUEUE_DATA
+#undef GLCD_QUEUE_AUTO
+#undef GLCD_QUEUE_RESET
+#undef GLCD_QUEUE_RESET_READ
+#undef GLCD_EDGE_CHUNK
+#undef GLCD_CLIP_LEFT
+#undef GLCD_CLIP_RIGHT
+#undef GLCD_CLIP_TOP
+#undef GLCD_CLIP_BOTTOM
+#undef GLCD_CharCode
+#undef GLCD_POW2_FONT
+#undef GLCD_COLUMN
+#undef GLCD_BIT
+#undef GLCD_TABLE_4
+#undef GLCD_TABLE_16
+#undef GLCD_TABLE_64
+#undef GLCD_TABLE_256
+#undef GLCD_TABLE_COLUMN
+#undef GLCD_TABLE_BIT
+#undef GLCD_MIN
+#undef GLCD_MAX
+#undef GLCD_CONSTRAIN
+
+#endif
@@ -0,0 +1,776 @@
+/*
+	Model of the T6963 controller for host builds of the T6963 library
+
+	See T6963_Emulator.h
+*/
+
+
+
+//*************************************************************************************************
+//	Libraries
+//*************************************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../T6963_Commands.h"
+#include "T6963_Emulator.h"
+
+
+//*************************************************************************************************
+//	Macro definitions
+//*************************************************************************************************
+
+// commands with the low bits as an argument
+#define EMU_COMMAND_GROUP(c)		((c) & 0xF0)
+#define EMU_CURSOR_GROUP(c)			((c) & 0xF8)
+
+// mode set bits above the text and graphic combination
+#define EMU_MODE_COMBINE			0x07
+#define EMU_MODE_CG_EXTERNAL		T6963_MODE_EXTERNAL
+
+// attribute mode (text attribute bytes in the graphic area)
+#define EMU_ATTRIBUTE				0x07
+#define EMU_ATTRIBUTE_REVERSE		0x05
+#define EMU_ATTRIBUTE_INHIBIT		0x03
+
+// auto modes
+#define EMU_AUTO_OFF				0
+#define EMU_AUTO_WRITE				1
+#define EMU_AUTO_READ				2
+
+// status bits a command leaves low while it runs
+#define EMU_STATUS_ALL				(T6963_STATUS_COMMAND | T6963_STATUS_DATA | T6963_STATUS_AUTO_READ | T6963_STATUS_AUTO_WRITE)
+
+// internal CG rom characters that have a glyph
+#define EMU_ROM_GLYPHS				95
+
+
+
+
+
+
+//*************************************************************************************************
+//	Global variables
+//*************************************************************************************************
+
+T6963Emulator *T6963Emulator::attached = 0;
+
+//-------------------------------------------------------------------------------------------------
+//
+// Internal CG rom, five columns per character (bit 0 is the top row), code 0x00 is ascii space
+//
+//-------------------------------------------------------------------------------------------------
+
+static const uint8_t emuRom[EMU_ROM_GLYPHS * 5] =
+{
+	0x00, 0x00, 0x00, 0x00, 0x00,	// 0x00 space
+	0x00, 0x00, 0x5F, 0x00, 0x00,	// 0x01 !
+	0x00, 0x07, 0x00, 0x07, 0x00,	// 0x02 "
+	0x14, 0x7F, 0x14, 0x7F, 0x14,	// 0x03 #
+	0x24, 0x2A, 0x7F, 0x2A, 0x12,	// 0x04 $
+	0x23, 0x13, 0x08, 0x64, 0x62,	// 0x05 %
+	0x36, 0x49, 0x55, 0x22, 0x50,	// 0x06 &
+	0x00, 0x05, 0x03, 0x00, 0x00,	// 0x07 quote
+	0x00, 0x1C, 0x22, 0x41, 0x00,	// 0x08 (
+	0x00, 0x41, 0x22, 0x1C, 0x00,	// 0x09 )
+	0x08, 0x2A, 0x1C, 0x2A, 0x08,	// 0x0A *
+	0x08, 0x08, 0x3E, 0x08, 0x08,	// 0x0B +
+	0x00, 0x50, 0x30, 0x00, 0x00,	// 0x0C ,
+	0x08, 0x08, 0x08, 0x08, 0x08,	// 0x0D -
+	0x00, 0x60, 0x60, 0x00, 0x00,	// 0x0E .
+	0x20, 0x10, 0x08, 0x04, 0x02,	// 0x0F /
+	0x3E, 0x51, 0x49, 0x45, 0x3E,	// 0x10 0
+	0x00, 0x42, 0x7F, 0x40, 0x00,	// 0x11 1
+	0x42, 0x61, 0x51, 0x49, 0x46,	// 0x12 2
+	0x21, 0x41, 0x45, 0x4B, 0x31,	// 0x13 3
+	0x18, 0x14, 0x12, 0x7F, 0x10,	// 0x14 4
+	0x27, 0x45, 0x45, 0x45, 0x39,	// 0x15 5
+	0x3C, 0x4A, 0x49, 0x49, 0x30,	// 0x16 6
+	0x01, 0x71, 0x09, 0x05, 0x03,	// 0x17 7
+	0x36, 0x49, 0x49, 0x49, 0x36,	// 0x18 8
+	0x06, 0x49, 0x49, 0x29, 0x1E,	// 0x19 9
+	0x00, 0x36, 0x36, 0x00, 0x00,	// 0x1A :
+	0x00, 0x56, 0x36, 0x00, 0x00,	// 0x1B ;
+	0x08, 0x14, 0x22, 0x41, 0x00,	// 0x1C <
+	0x14, 0x14, 0x14, 0x14, 0x14,	// 0x1D =
+	0x00, 0x41, 0x22, 0x14, 0x08,	// 0x1E >
+	0x02, 0x01, 0x51, 0x09, 0x06,	// 0x1F ?
+	0x32, 0x49, 0x79, 0x41, 0x3E,	// 0x20 @
+	0x7E, 0x11, 0x11, 0x11, 0x7E,	// 0x21 A
+	0x7F, 0x49, 0x49, 0x49, 0x36,	// 0x22 B
+	0x3E, 0x41, 0x41, 0x41, 0x22,	// 0x23 C
+	0x7F, 0x41, 0x41, 0x22, 0x1C,	// 0x24 D
+	0x7F, 0x49, 0x49, 0x49, 0x41,	// 0x25 E
+	0x7F, 0x09, 0x09, 0x01, 0x01,	// 0x26 F
+	0x3E, 0x41, 0x41, 0x51, 0x32,	// 0x27 G
+	0x7F, 0x08, 0x08, 0x08, 0x7F,	// 0x28 H
+	0x00, 0x41, 0x7F, 0x41, 0x00,	// 0x29 I
+	0x20, 0x40, 0x41, 0x3F, 0x01,	// 0x2A J
+	0x7F, 0x08, 0x14, 0x22, 0x41,	// 0x2B K
+	0x7F, 0x40, 0x40, 0x40, 0x40,	// 0x2C L
+	0x7F, 0x02, 0x04, 0x02, 0x7F,	// 0x2D M
+	0x7F, 0x04, 0x08, 0x10, 0x7F,	// 0x2E N
+	0x3E, 0x41, 0x41, 0x41, 0x3E,	// 0x2F O
+	0x7F, 0x09, 0x09, 0x09, 0x06,	// 0x30 P
+	0x3E, 0x41, 0x51, 0x21, 0x5E,	// 0x31 Q
+	0x7F, 0x09, 0x19, 0x29, 0x46,	// 0x32 R
+	0x46, 0x49, 0x49, 0x49, 0x31,	// 0x33 S
+	0x01, 0x01, 0x7F, 0x01, 0x01,	// 0x34 T
+	0x3F, 0x40, 0x40, 0x40, 0x3F,	// 0x35 U
+	0x1F, 0x20, 0x40, 0x20, 0x1F,	// 0x36 V
+	0x7F, 0x20, 0x18, 0x20, 0x7F,	// 0x37 W
+	0x63, 0x14, 0x08, 0x14, 0x63,	// 0x38 X
+	0x03, 0x04, 0x78, 0x04, 0x03,	// 0x39 Y
+	0x61, 0x51, 0x49, 0x45, 0x43,	// 0x3A Z
+	0x00, 0x00, 0x7F, 0x41, 0x41,	// 0x3B [
+	0x02, 0x04, 0x08, 0x10, 0x20,	// 0x3C backslash
+	0x41, 0x41, 0x7F, 0x00, 0x00,	// 0x3D ]
+	0x04, 0x02, 0x01, 0x02, 0x04,	// 0x3E ^
+	0x40, 0x40, 0x40, 0x40, 0x40,	// 0x3F _
+	0x00, 0x01, 0x02, 0x04, 0x00,	// 0x40 `
+	0x20, 0x54, 0x54, 0x54, 0x78,	// 0x41 a
+	0x7F, 0x48, 0x44, 0x44, 0x38,	// 0x42 b
+	0x38, 0x44, 0x44, 0x44, 0x20,	// 0x43 c
+	0x38, 0x44, 0x44, 0x48, 0x7F,	// 0x44 d
+	0x38, 0x54, 0x54, 0x54, 0x18,	// 0x45 e
+	0x08, 0x7E, 0x09, 0x01, 0x02,	// 0x46 f
+	0x08, 0x14, 0x54, 0x54, 0x3C,	// 0x47 g
+	0x7F, 0x08, 0x04, 0x04, 0x78,	// 0x48 h
+	0x00, 0x44, 0x7D, 0x40, 0x00,	// 0x49 i
+	0x20, 0x40, 0x44, 0x3D, 0x00,	// 0x4A j
+	0x00, 0x7F, 0x10, 0x28, 0x44,	// 0x4B k
+	0x00, 0x41, 0x7F, 0x40, 0x00,	// 0x4C l
+	0x7C, 0x04, 0x18, 0x04, 0x78,	// 0x4D m
+	0x7C, 0x08, 0x04, 0x04, 0x78,	// 0x4E n
+	0x38, 0x44, 0x44, 0x44, 0x38,	// 0x4F o
+	0x7C, 0x14, 0x14, 0x14, 0x08,	// 0x50 p
+	0x08, 0x14, 0x14, 0x18, 0x7C,	// 0x51 q
+	0x7C, 0x08, 0x04, 0x04, 0x08,	// 0x52 r
+	0x48, 0x54, 0x54, 0x54, 0x20,	// 0x53 s
+	0x04, 0x3F, 0x44, 0x40, 0x20,	// 0x54 t
+	0x3C, 0x40, 0x40, 0x20, 0x7C,	// 0x55 u
+	0x1C, 0x20, 0x40, 0x20, 0x1C,	// 0x56 v
+	0x3C, 0x40, 0x30, 0x40, 0x3C,	// 0x57 w
+	0x44, 0x28, 0x10, 0x28, 0x44,	// 0x58 x
+	0x0C, 0x50, 0x50, 0x50, 0x3C,	// 0x59 y
+	0x44, 0x64, 0x54, 0x4C, 0x44,	// 0x5A z
+	0x00, 0x08, 0x36, 0x41, 0x00,	// 0x5B {
+	0x00, 0x00, 0x7F, 0x00, 0x00,	// 0x5C |
+	0x00, 0x41, 0x36, 0x08, 0x00,	// 0x5D }
+	0x02, 0x01, 0x02, 0x04, 0x02,	// 0x5E ~
+};
+
+
+
+
+
+
+//*************************************************************************************************
+//	Host bus
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Bus cycles from T6963BusHost, these replace the library's weak versions
+//
+//-------------------------------------------------------------------------------------------------
+
+uint8_t t6963HostRead(uint8_t status)
+{
+	if (!T6963Emulator::attached)
+	{
+		return status ? (T6963_STATUS_COMMAND | T6963_STATUS_DATA | T6963_STATUS_AUTO_READ | T6963_STATUS_AUTO_WRITE) : 0;
+	}
+	
+	return T6963Emulator::attached->read(status);
+}
+
+void t6963HostWrite(uint8_t command, uint8_t data)
+{
+	if (T6963Emulator::attached)
+	{
+		T6963Emulator::attached->write(command, data);
+	}
+}
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Bus Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read cycle
+//
+//	Input	status: 1 for a status read (C/D high), 0 for a data read
+//
+//	Output	status or data byte
+//
+//-------------------------------------------------------------------------------------------------
+
+uint8_t T6963Emulator::read(uint8_t status)
+{
+	uint8_t data;
+	
+	if (status)
+	{
+		statusReads++;
+		
+		data = T6963_STATUS_COMMAND | T6963_STATUS_DATA;
+		
+		if (_auto == EMU_AUTO_READ)
+		{
+			data |= T6963_STATUS_AUTO_READ;
+		}
+		
+		if (_auto == EMU_AUTO_WRITE)
+		{
+			data |= T6963_STATUS_AUTO_WRITE;
+		}
+		
+		if (_busy)
+		{
+			_busy--;
+			data &= ~_busyStatus;
+		}
+		
+		return data;
+	}
+	
+	dataReads++;
+	
+	if (_auto == EMU_AUTO_READ)
+	{
+		cycle(T6963_STATUS_AUTO_READ, T6963_STATUS_AUTO_READ);
+		return memory[_pointer++];
+	}
+	
+	cycle(T6963_STATUS_COMMAND | T6963_STATUS_DATA, 0);
+	
+	if (_auto == EMU_AUTO_WRITE)
+	{
+		errors++;
+	}
+	
+	return _latch;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Write cycle
+//
+//	Input	command: 1 for a command write (C/D high), 0 for a data write
+//			data: byte on the bus
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+void T6963Emulator::write(uint8_t command, uint8_t data)
+{
+	if (command)
+	{
+		commands++;
+		
+		// in an auto mode the reset waits for STA2 / STA3 instead of STA0 and STA1
+		if (_auto == EMU_AUTO_READ)
+		{
+			cycle(T6963_STATUS_AUTO_READ, EMU_STATUS_ALL);
+		}
+		else if (_auto == EMU_AUTO_WRITE)
+		{
+			cycle(T6963_STATUS_AUTO_WRITE, EMU_STATUS_ALL);
+		}
+		else
+		{
+			cycle(T6963_STATUS_COMMAND | T6963_STATUS_DATA, EMU_STATUS_ALL);
+		}
+		
+		// only the auto reset ends an auto mode
+		if (_auto != EMU_AUTO_OFF && data != T6963_AUTO_RESET)
+		{
+			errors++;
+			return;
+		}
+		
+		this->command(data);
+		return;
+	}
+	
+	dataWrites++;
+	
+	if (_auto == EMU_AUTO_WRITE)
+	{
+		cycle(T6963_STATUS_AUTO_WRITE, T6963_STATUS_AUTO_WRITE);
+		memory[_pointer++] = data;
+		return;
+	}
+	
+	// the datasheet asks for STA0 and STA1 before every argument, as before a command
+	cycle(T6963_STATUS_COMMAND | T6963_STATUS_DATA, T6963_STATUS_COMMAND | T6963_STATUS_DATA);
+	
+	if (_auto == EMU_AUTO_READ || _argCount >= 2)
+	{
+		errors++;
+		return;
+	}
+	
+	_args[_argCount++] = data;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Check a bus cycle against the busy time left by the one before, then start its own
+//
+//	Input	needs: status bits the driver has to see set before the cycle
+//			drops: status bits that read low for busyCycles status reads after it
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+void T6963Emulator::cycle(uint8_t needs, uint8_t drops)
+{
+	if (_busy && (_busyStatus & needs))
+	{
+		errors++;
+	}
+	
+	_busy = drops ? busyCycles : 0;
+	_busyStatus = drops;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Run a command with the data bytes written before it
+//
+//	Input	code: command code
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+void T6963Emulator::command(uint8_t code)
+{
+	uint16_t word, row, col;
+	
+	word = _args[0] | (_args[1] << 8);
+	_argCount = 0;
+	
+	switch (code)
+	{
+		case T6963_SET_CURSOR_POINTER:
+			_cursorX = _args[0];
+			_cursorY = _args[1];
+			return;
+			
+		case T6963_SET_OFFSET_REGISTER:
+			_offset = _args[0] & 0x1F;
+			return;
+			
+		case T6963_SET_ADDRESS_POINTER:
+			_pointer = word;
+			return;
+			
+		case T6963_SET_TEXT_HOME_ADDRESS:
+			_textHome = word;
+			return;
+			
+		case T6963_SET_TEXT_AREA:
+			_textArea = _args[0];
+			return;
+			
+		case T6963_SET_GRAPHIC_HOME_ADDRESS:
+			_graphHome = word;
+			return;
+			
+		case T6963_SET_GRAPHIC_AREA:
+			_graphArea = _args[0];
+			return;
+			
+		case T6963_SET_DATA_AUTO_WRITE:
+			_auto = EMU_AUTO_WRITE;
+			return;
+			
+		case T6963_SET_DATA_AUTO_READ:
+			_auto = EMU_AUTO_READ;
+			return;
+			
+		case T6963_AUTO_RESET:
+			_auto = EMU_AUTO_OFF;
+			return;
+			
+		case T6963_DATA_WRITE_AND_INCREMENT:
+			memory[_pointer++] = _args[0];
+			return;
+			
+		case T6963_DATA_READ_AND_INCREMENT:
+			_latch = memory[_pointer++];
+			return;
+			
+		case T6963_DATA_WRITE_AND_DECREMENT:
+			memory[_pointer--] = _args[0];
+			return;
+			
+		case T6963_DATA_READ_AND_DECREMENT:
+			_latch = memory[_pointer--];
+			return;
+			
+		case T6963_DATA_WRITE_AND_NONVARIABLE:
+			memory[_pointer] = _args[0];
+			return;
+			
+		case T6963_DATA_READ_AND_NONVARIABLE:
+			_latch = memory[_pointer];
+			return;
+			
+		// the shown pixels of a graphic area byte
+		case T6963_SCREEN_PEEK:
+			if (_pointer < _graphHome || !_graphArea)
+			{
+				errors++;
+				return;
+			}
+			
+			row = (_pointer - _graphHome) / _graphArea;
+			col = (_pointer - _graphHome) % _graphArea;
+			_latch = screenByte(col, row);
+			return;
+			
+		// the shown pixels of a whole row written back to the graphic area
+		case T6963_SCREEN_COPY:
+			if (_pointer < _graphHome || !_graphArea)
+			{
+				errors++;
+				return;
+			}
+			
+			row = (_pointer - _graphHome) / _graphArea;
+			
+			for (col = 0; col < _graphArea; col++)
+			{
+				memory[(uint16_t)(_graphHome + row * _graphArea + col)] = screenByte(col, row);
+			}
+			
+			return;
+	}
+	
+	switch (EMU_COMMAND_GROUP(code))
+	{
+		case T6963_MODE_SET:
+			_mode = code & 0x0F;
+			return;
+			
+		case T6963_DISPLAY_MODE:
+			_display = code & 0x0F;
+			return;
+			
+		case T6963_SET_PIXEL:
+			if (code & T6963_BIT_SET)
+			{
+				memory[_pointer] |= 1 << (code & 0x07);
+			}
+			else
+			{
+				memory[_pointer] &= ~(1 << (code & 0x07));
+			}
+			
+			return;
+	}
+	
+	if (EMU_CURSOR_GROUP(code) == T6963_CURSOR_PATTERN_SELECT)
+	{
+		_cursorLines = (code & 0x07) + 1;
+		return;
+	}
+	
+	errors++;
+}
+
+
+
+
+
+
+//*************************************************************************************************
+//
+//		Screen Functions
+//
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// One row of a character's glyph
+//
+//	Input	code: character code
+//			line: row in the character, 0 - 7
+//
+//	Output	pixels, bit font - 1 is the left one
+//
+//-------------------------------------------------------------------------------------------------
+
+uint8_t T6963Emulator::glyphRow(uint8_t code, uint8_t line)
+{
+	uint8_t bits, column;
+	const uint8_t *glyph;
+	
+	// CG ram holds codes 0x80 and up, or all of them with external CG
+	if (code >= 0x80 || (_mode & EMU_MODE_CG_EXTERNAL))
+	{
+		return memory[(uint16_t)((_offset << 11) + code * 8 + line)];
+	}
+	
+	if (code >= EMU_ROM_GLYPHS || line == 7)
+	{
+		return 0;
+	}
+	
+	glyph = &emuRom[code * 5];
+	bits = 0;
+	
+	for (column = 0; column < 5; column++)
+	{
+		if (glyph[column] & (1 << line))
+		{
+			bits |= 1 << (_font - 1 - column);
+		}
+	}
+	
+	return bits;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Pixels shown in one column of a row
+//
+//	Input	col: graphic column
+//			y: pixel row
+//
+//	Output	pixels, bit font - 1 is the left one
+//
+//-------------------------------------------------------------------------------------------------
+
+uint8_t T6963Emulator::screenByte(uint16_t col, uint16_t y)
+{
+	uint8_t text, graph, attribute, line;
+	uint16_t row;
+	
+	row = y / 8;
+	line = y % 8;
+	
+	text = 0;
+	graph = 0;
+	
+	if (_display & (1 << T6963_DISPLAY_TEXT))
+	{
+		text = glyphRow(memory[(uint16_t)(_textHome + row * _textArea + col)], line);
+		
+		if ((_display & (1 << T6963_DISPLAY_CURSOR)) && col == _cursorX && row == _cursorY && line >= 8 - _cursorLines)
+		{
+			text = 0xFF;
+		}
+	}
+	
+	// attribute mode uses the graphic area for a byte per character
+	if ((_mode & EMU_MODE_COMBINE) == T6963_MODE_TEXT)
+	{
+		attribute = memory[(uint16_t)(_graphHome + row * _graphArea + col)] & EMU_ATTRIBUTE;
+		
+		if (attribute == EMU_ATTRIBUTE_REVERSE)
+		{
+			text = ~text;
+		}
+		else if (attribute == EMU_ATTRIBUTE_INHIBIT)
+		{
+			text = 0;
+		}
+		
+		return text & ((1 << _font) - 1);
+	}
+	
+	if (_display & (1 << T6963_DISPLAY_GRAPHIC))
+	{
+		graph = memory[(uint16_t)(_graphHome + y * _graphArea + col)];
+	}
+	
+	switch (_mode & EMU_MODE_COMBINE)
+	{
+		case T6963_MODE_XOR:
+			text ^= graph;
+			break;
+			
+		// with one plane off the other shows as it is
+		case T6963_MODE_AND:
+			if ((_display & (1 << T6963_DISPLAY_TEXT)) && (_display & (1 << T6963_DISPLAY_GRAPHIC)))
+			{
+				text &= graph;
+			}
+			else
+			{
+				text |= graph;
+			}
+			
+			break;
+			
+		default:
+			text |= graph;
+			break;
+	}
+	
+	return text & ((1 << _font) - 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Pixel shown on the panel
+//
+//	Input	x, y: pixel
+//
+//	Output	1 = dark; 0 = clear
+//
+//-------------------------------------------------------------------------------------------------
+
+uint8_t T6963Emulator::pixel(uint16_t x, uint16_t y)
+{
+	if (x >= _width || y >= _height)
+	{
+		return 0;
+	}
+	
+	return (screenByte(x / _font, y) >> (_font - 1 - x % _font)) & 0x01;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Save the panel as a binary (P4) PBM image
+//
+//	Input	*file: file name
+//
+//	Output	1 when it was written
+//
+//-------------------------------------------------------------------------------------------------
+
+uint8_t T6963Emulator::savePbm(const char *file)
+{
+	FILE *image;
+	uint16_t x, y;
+	uint8_t bits;
+	
+	image = fopen(file, "wb");
+	
+	if (!image)
+	{
+		return 0;
+	}
+	
+	fprintf(image, "P4\n%u %u\n", _width, _height);
+	
+	for (y = 0; y < _height; y++)
+	{
+		bits = 0;
+		
+		for (x = 0; x < _width; x++)
+		{
+			bits = (bits << 1) | pixel(x, y);
+			
+			if ((x & 7) == 7)
+			{
+				fputc(bits, image);
+				bits = 0;
+			}
+		}
+		
+		if (_width & 7)
+		{
+			fputc(bits << (8 - (_width & 7)), image);
+		}
+	}
+	
+	return fclose(image) == 0;
+}
+
+
+
+
+
+
+//*************************************************************************************************
+//	Emulator initialization
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Power on state, display ram cleared and the bus counters zeroed
+//
+//	Input	none
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+void T6963Emulator::reset(void)
+{
+	memset(memory, 0, sizeof(memory));
+	
+	_pointer = 0;
+	_textHome = 0;
+	_textArea = 0;
+	_graphHome = 0;
+	_graphArea = 0;
+	_offset = 0;
+	_cursorX = 0;
+	_cursorY = 0;
+	_cursorLines = 1;
+	_mode = 0;
+	_display = 0;
+	_auto = EMU_AUTO_OFF;
+	_latch = 0;
+	_args[0] = 0;
+	_args[1] = 0;
+	_argCount = 0;
+	_busy = 0;
+	_busyStatus = 0;
+	
+	statusReads = 0;
+	dataReads = 0;
+	dataWrites = 0;
+	commands = 0;
+	errors = 0;
+}
+
+
+
+
+
+
+//*************************************************************************************************
+//	Constructor
+//*************************************************************************************************
+
+T6963Emulator::T6963Emulator(uint16_t width, uint16_t height, uint8_t font)
+{
+	_width = width;
+	_height = height;
+	_font = font;
+	
+	busyCycles = 1;
+	
+	reset();
+	
+	attached = this;
+}
+
+T6963Emulator::~T6963Emulator()
+{
+	if (attached == this)
+	{
+		attached = 0;
+	}
+}
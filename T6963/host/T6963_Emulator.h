@@ -0,0 +1,92 @@
+/*
+	Model of the T6963 controller for host builds of the T6963 library
+
+	Linking T6963_Emulator.cpp into a host program puts an emulator behind the
+	host bus (t6963HostRead and t6963HostWrite in T6963_Bus.h). The last emulator
+	constructed is the one on the bus. It decodes the command set in
+	T6963_Commands.h on 64k of display ram and renders the text, graphic, CG
+	and cursor planes the way the panel shows them.
+
+		T6963Emulator panel(240, 128, 6);
+
+		LCD.init();
+		LCD.moveTo(10, 10);
+		LCD.rect(50, 20);
+		panel.savePbm("screen.pbm");
+
+	The internal CG rom only has the ascii characters (codes 0x00 - 0x5E), the
+	glyph sits in the left five columns of the cell.
+	
+	After each cycle the controller reads busy for busyCycles status reads. A
+	command clears all of the status bits, an argument byte STA0 and STA1 and an
+	auto mode byte its STA2 / STA3 bit, as the datasheet has the driver check
+	them before the next cycle. A cycle sent while a bit it needs reads low, and
+	any cycle the controller would not accept, counts in errors, so a driver
+	built with GLCD_SKIP_STATUS shows its skipped checks there.
+*/
+
+#ifndef T6963_EMULATOR_H
+#define T6963_EMULATOR_H
+
+#include <stdint.h>
+
+class T6963Emulator
+{
+	public:
+		T6963Emulator(uint16_t, uint16_t, uint8_t);
+		~T6963Emulator();
+		
+		void reset(void);
+		
+		uint8_t read(uint8_t);
+		void write(uint8_t, uint8_t);
+		
+		uint8_t pixel(uint16_t, uint16_t);
+		uint8_t savePbm(const char*);
+		
+		//Display ram
+		uint8_t memory[65536];
+		
+		//Status reads the controller stays busy after a cycle (1 unless set)
+		uint8_t busyCycles;
+		
+		//Bus cycles since reset()
+		uint32_t statusReads;
+		uint32_t dataReads;
+		uint32_t dataWrites;
+		uint32_t commands;
+		uint32_t errors;
+		
+		//The emulator behind the host bus
+		static T6963Emulator *attached;
+		
+	private:
+		uint16_t _width;
+		uint16_t _height;
+		uint8_t _font;
+		
+		uint16_t _pointer;
+		uint16_t _textHome;
+		uint16_t _textArea;
+		uint16_t _graphHome;
+		uint16_t _graphArea;
+		uint8_t _offset;
+		uint8_t _cursorX;
+		uint8_t _cursorY;
+		uint8_t _cursorLines;
+		uint8_t _mode;
+		uint8_t _display;
+		uint8_t _auto;
+		uint8_t _latch;
+		uint8_t _args[2];
+		uint8_t _argCount;
+		uint8_t _busy;
+		uint8_t _busyStatus;
+		
+		void cycle(uint8_t, uint8_t);
+		void command(uint8_t);
+		uint8_t glyphRow(uint8_t, uint8_t);
+		uint8_t screenByte(uint16_t, uint16_t);
+};
+
+#endif
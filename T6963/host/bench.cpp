@@ -0,0 +1,677 @@
+/*
+	Bus cost of the T6963 drawing functions on the host emulator
+
+	Every benchmark starts from a cleared screen with the pen at 0, 0 and runs a
+	fixed workload, the emulator counts the bus cycles it takes. Bus time is an
+	estimate for an AVR at F_CPU: each cycle holds its strobe for the datasheet
+	time in T6963_Bus.h plus BENCH_CYCLE_OVERHEAD cpu cycles of port handling.
+
+	Results are written as csv, one line per benchmark, memory is a checksum of
+	the display ram after the workload:
+		name,calls,status_reads,data_reads,data_writes,commands,bus_us,memory
+
+	Given a baseline csv from an earlier run, any benchmark that needs more bus
+	cycles than before or leaves different display ram is reported and the exit
+	status is 1.
+
+	Usage:
+		bench results.csv [baseline.csv]
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../T6963.h"
+#include "T6963_Emulator.h"
+
+
+//*************************************************************************************************
+//	Definitions
+//*************************************************************************************************
+
+#ifndef F_CPU
+	#define F_CPU	16000000UL
+#endif
+
+// cpu cycles around each strobe (port direction, data and control writes)
+#define BENCH_CYCLE_OVERHEAD	6
+
+#define BENCH_MAX				64
+
+static T6963Emulator panel(SCREEN_WIDTH, SCREEN_HEIGHT, FONT_WIDTH);
+
+static const uint8_t benchBitmap[] PROGMEM =
+{
+	0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C,
+	0xFF, 0x81, 0xBD, 0xA5, 0xA5, 0xBD, 0x81, 0xFF
+};
+
+static const prog_char benchString[] PROGMEM = "program memory text";
+
+static uint32_t benchSeed;
+
+static void startCounting(void);
+
+struct Bench
+{
+	const char *name;
+	uint16_t (*run)(void);
+};
+
+struct Result
+{
+	char name[32];
+	uint32_t calls;
+	uint32_t statusReads;
+	uint32_t dataReads;
+	uint32_t dataWrites;
+	uint32_t commands;
+	uint32_t busTime;
+	uint32_t memory;
+};
+
+
+
+
+
+
+//*************************************************************************************************
+//	Workloads (each returns the number of library calls it made)
+//*************************************************************************************************
+
+// pseudo random step from -range to range, the same sequence on every host
+static int16_t benchRandom(int16_t range)
+{
+	benchSeed = benchSeed * 1103515245UL + 12345UL;
+	
+	return (int16_t)((benchSeed >> 16) % (2 * range + 1)) - range;
+}
+
+static uint16_t benchHorizLine(void)
+{
+	uint16_t calls = 0;
+	uint8_t y;
+	
+	for (y = 0; y < SCREEN_HEIGHT; y += 8)
+	{
+		LCD.moveTo(y % 37, y);
+		LCD.horizLine(SCREEN_WIDTH - 1 - 2 * (y % 37));
+		LCD.moveTo(y, y + 3);
+		LCD.horizLine(y % 11 + 1);
+		calls += 2;
+	}
+	
+	return calls;
+}
+
+static uint16_t benchVertLine(void)
+{
+	uint16_t calls = 0;
+	uint8_t x;
+	
+	for (x = 0; x < SCREEN_WIDTH; x += 12)
+	{
+		LCD.moveTo(x, x % 29);
+		LCD.vertLine(SCREEN_HEIGHT - 1 - 2 * (x % 29));
+		calls++;
+	}
+	
+	return calls;
+}
+
+static uint16_t benchDiagLine(void)
+{
+	uint16_t calls = 0;
+	uint8_t x;
+	
+	for (x = 0; x < SCREEN_WIDTH - SCREEN_HEIGHT; x += 8)
+	{
+		LCD.moveTo(x, 0);
+		LCD.diagLine(SCREEN_HEIGHT - 1, 0);
+		LCD.moveTo(x + 4, SCREEN_HEIGHT - 1);
+		LCD.diagLine(SCREEN_HEIGHT / 2, 1);
+		calls += 2;
+	}
+	
+	return calls;
+}
+
+static uint16_t benchBresenLine(void)
+{
+	uint16_t calls = 0;
+	uint8_t angle;
+	
+	// a fan of slopes from the centre, none of them straight or 45 degrees
+	for (angle = 1; angle < 32; angle += 2)
+	{
+		LCD.moveTo(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+		LCD.bresenLine(100, angle * 2 - 32);
+		LCD.moveTo(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+		LCD.bresenLine(angle * 3 - 48, 60);
+		calls += 2;
+	}
+	
+	return calls;
+}
+
+static uint16_t benchLine(void)
+{
+	uint16_t calls = 0;
+	int16_t step;
+	
+	// lines to and from past the edges, clipped on the way
+	for (step = -60; step <= SCREEN_WIDTH + 60; step += 30)
+	{
+		LCD.moveTo(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+		LCD.line(step - SCREEN_WIDTH / 2, -SCREEN_HEIGHT);
+		LCD.moveTo(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+		LCD.line(step - SCREEN_WIDTH / 2, SCREEN_HEIGHT);
+		calls += 4;
+	}
+	
+	return calls;
+}
+
+static uint16_t benchMoveLine(void)
+{
+	uint16_t step;
+	int16_t x, y, dx, dy;
+	
+	// a random walk of moves and lines that wanders up to 20 pixels past the edges
+	benchSeed = 1;
+	x = SCREEN_WIDTH / 2;
+	y = SCREEN_HEIGHT / 2;
+	LCD.moveTo(x, y);
+	
+	for (step = 0; step < 3000; step++)
+	{
+		dx = benchRandom(40);
+		dy = benchRandom(24);
+		
+		if (x + dx < -20 || x + dx >= SCREEN_WIDTH + 20)
+		{
+			dx = -dx;
+		}
+		
+		if (y + dy < -20 || y + dy >= SCREEN_HEIGHT + 20)
+		{
+			dy = -dy;
+		}
+		
+		if (step & 0x03)
+		{
+			LCD.line(dx, dy);
+		}
+		else
+		{
+			LCD.move(dx, dy);
+		}
+		
+		x += dx;
+		y += dy;
+	}
+	
+	return 3001;
+}
+
+static uint16_t benchRect(void)
+{
+	uint16_t calls = 0;
+	uint8_t size;
+	
+	for (size = 4; size < SCREEN_HEIGHT / 2; size += 6)
+	{
+		LCD.moveTo(SCREEN_WIDTH / 2 - size, SCREEN_HEIGHT / 2 - size);
+		LCD.rect(2 * size, 2 * size - 1);
+		LCD.moveTo(size, size);
+		LCD.rect(size + 20, size, 3);
+		calls += 4;
+	}
+	
+	return calls;
+}
+
+static uint16_t benchFillRect(void)
+{
+	uint16_t calls = 0;
+	uint8_t size;
+	
+	for (size = 4; size < SCREEN_HEIGHT / 2; size += 6)
+	{
+		LCD.setColor((size / 6) & 0x01);
+		LCD.moveTo(SCREEN_WIDTH / 2 - size, SCREEN_HEIGHT / 2 - size);
+		LCD.fillRect(2 * size, 2 * size - 1);
+		LCD.moveTo(size, size);
+		LCD.fillRect(size + 20, size, 3);
+		calls += 5;
+	}
+	
+	LCD.setColor(1);
+	
+	return calls;
+}
+
+static uint16_t benchCircle(void)
+{
+	uint16_t calls = 0;
+	uint8_t radius;
+	
+	for (radius = 2; radius < SCREEN_HEIGHT / 2; radius += 5)
+	{
+		LCD.moveTo(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+		LCD.circle(radius);
+		LCD.ellipse(radius + 20, radius);
+		LCD.arc(radius, 30, 240);
+		calls += 4;
+	}
+	
+	return calls;
+}
+
+static uint16_t benchFillCircle(void)
+{
+	uint16_t calls = 0;
+	uint8_t radius;
+	
+	for (radius = 2; radius < SCREEN_HEIGHT / 2; radius += 10)
+	{
+		LCD.setColor((radius / 10) & 0x01);
+		LCD.moveTo(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+		LCD.fillCircle(radius);
+		LCD.fillEllipse(radius + 20, radius);
+		LCD.fillArc(radius, 200, 20);
+		calls += 5;
+	}
+	
+	LCD.setColor(1);
+	
+	return calls;
+}
+
+static uint16_t benchFillPoly(void)
+{
+	uint16_t calls = 0;
+	uint8_t point;
+	
+	// a star and a triangle hanging off the screen
+	LCD.beginPoly();
+	
+	for (point = 0; point < 10; point++)
+	{
+		LCD.vertex(SCREEN_WIDTH / 2 + (point & 0x01 ? 20 : 60) * ((point * 7) % 10 - 4) / 5, (point * 13) % SCREEN_HEIGHT);
+	}
+	
+	LCD.fillPoly();
+	
+	LCD.beginPoly();
+	LCD.vertex(-40, 10);
+	LCD.vertex(80, SCREEN_HEIGHT + 30);
+	LCD.vertex(60, 20);
+	LCD.fillPoly();
+	
+	calls += 17;
+	
+	return calls;
+}
+
+static uint16_t benchDrawBitmap(void)
+{
+	uint16_t calls = 0;
+	uint8_t x;
+	
+	for (x = 0; x < SCREEN_WIDTH - 16; x += 19)
+	{
+		LCD.drawBitmapPgm(x, x / 4, 8, 16, benchBitmap);
+		calls++;
+	}
+	
+	return calls;
+}
+
+static uint16_t benchCopyRegion(void)
+{
+	// only the copies are counted, not drawing the region
+	LCD.moveTo(10, 10);
+	LCD.fillRect(40, 30, 4);
+	startCounting();
+	
+	LCD.copyRegion(10, 10, 44, 34, 100, 50);
+	LCD.copyRegion(10, 10, 44, 34, 13, 60);
+	
+	return 2;
+}
+
+static uint16_t benchText(void)
+{
+	uint16_t calls = 0;
+	uint8_t row;
+	
+	for (row = 0; row < SCREEN_ROWS; row++)
+	{
+		LCD.textTo(row, row);
+		LCD.text((char*)"text string");
+		LCD.textTo(0, row);
+		LCD.textPgm((prog_char*)benchString);
+		LCD.textTo(SCREEN_COLS - 1, row);
+		LCD.text((char*)"backward", -8);
+		calls += 6;
+	}
+	
+	// the same text again, only the changed cells matter with a text shadow
+	LCD.textTo(0, 0);
+	LCD.textPgm((prog_char*)benchString);
+	calls += 2;
+	
+	return calls;
+}
+
+static uint16_t benchBigText(void)
+{
+	LCD.loadBigDigits(0x80);
+	LCD.textTo(0, 0);
+	LCD.bigText((char*)"-12.5");
+	LCD.textTo(0, 4);
+	LCD.bigText((char*)"67890");
+	
+	return 5;
+}
+
+static uint16_t benchClearText(void)
+{
+	LCD.clearText();
+	LCD.textTo(3, 2);
+	LCD.clearText(SCREEN_COLS);
+	LCD.clearText(-SCREEN_COLS / 2);
+	
+	return 4;
+}
+
+static uint16_t benchClearGraph(void)
+{
+	LCD.clearGraph();
+	
+	return 1;
+}
+
+static const Bench benches[] =
+{
+	{"horizLine", benchHorizLine},
+	{"vertLine", benchVertLine},
+	{"diagLine", benchDiagLine},
+	{"bresenLine", benchBresenLine},
+	{"line", benchLine},
+	{"moveLine", benchMoveLine},
+	{"rect", benchRect},
+	{"fillRect", benchFillRect},
+	{"circle", benchCircle},
+	{"fillCircle", benchFillCircle},
+	{"fillPoly", benchFillPoly},
+	{"drawBitmapPgm", benchDrawBitmap},
+	{"copyRegion", benchCopyRegion},
+	{"text", benchText},
+	{"bigText", benchBigText},
+	{"clearText", benchClearText},
+	{"clearGraph", benchClearGraph}
+};
+
+
+
+
+
+
+//*************************************************************************************************
+//	Harness
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Checksum of the emulator's display ram (32 bit FNV-1a)
+//
+//-------------------------------------------------------------------------------------------------
+
+static uint32_t memoryHash(void)
+{
+	uint32_t hash;
+	uint32_t index;
+	
+	hash = 2166136261UL;
+	
+	for (index = 0; index < sizeof(panel.memory); index++)
+	{
+		hash = (hash ^ panel.memory[index]) * 16777619UL;
+	}
+	
+	return hash;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Send everything drawn so far and zero the counters, a workload calls it
+// after drawing what it works on
+//
+//-------------------------------------------------------------------------------------------------
+
+static void startCounting(void)
+{
+	LCD.flush();
+	
+#ifdef GLCD_QUEUE
+	LCD.sync();
+#endif
+
+	panel.statusReads = 0;
+	panel.dataReads = 0;
+	panel.dataWrites = 0;
+	panel.commands = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Run one benchmark from a cleared screen
+//
+//	Input	*bench: the benchmark
+//			*result: counts and estimated bus time
+//
+//	Output	none
+//
+//-------------------------------------------------------------------------------------------------
+
+static void runBench(const Bench *bench, Result *result)
+{
+	LCD.setColor(1);
+	LCD.clearClip();
+	LCD.clearText();
+	LCD.clearGraph();
+	LCD.moveTo(0, 0);
+	LCD.textTo(0, 0);
+	startCounting();
+	
+	result->calls = bench->run();
+	
+	LCD.flush();
+	
+#ifdef GLCD_QUEUE
+	LCD.sync();
+#endif
+
+	strncpy(result->name, bench->name, sizeof(result->name) - 1);
+	result->name[sizeof(result->name) - 1] = 0;
+	result->statusReads = panel.statusReads;
+	result->dataReads = panel.dataReads;
+	result->dataWrites = panel.dataWrites;
+	result->commands = panel.commands;
+	result->memory = memoryHash();
+	
+	// reads hold the strobe for the access time, writes for the pulse width
+	result->busTime = ((result->statusReads + result->dataReads) * (GLCD_CYCLES(GLCD_T_ACC) + BENCH_CYCLE_OVERHEAD) +
+		(result->dataWrites + result->commands) * (GLCD_CYCLES(GLCD_T_CE) + BENCH_CYCLE_OVERHEAD)) / (F_CPU / 1000000UL);
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Bus cycles of a result
+//
+//-------------------------------------------------------------------------------------------------
+
+static uint32_t busCycles(const Result *result)
+{
+	return result->statusReads + result->dataReads + result->dataWrites + result->commands;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Read the results of an earlier run
+//
+//	Input	*file: csv file
+//			*results: space for BENCH_MAX results
+//
+//	Output	number of results read, -1 when the file cannot be opened
+//
+//-------------------------------------------------------------------------------------------------
+
+static int16_t readResults(const char *file, Result *results)
+{
+	FILE *csv;
+	char line[160];
+	int16_t count;
+	unsigned long calls, statusReads, dataReads, dataWrites, commands, busTime, memory;
+	Result *result;
+	
+	csv = fopen(file, "r");
+	
+	if (!csv)
+	{
+		return -1;
+	}
+	
+	count = 0;
+	
+	while (count < BENCH_MAX && fgets(line, sizeof(line), csv))
+	{
+		result = &results[count];
+		
+		if (sscanf(line, "%31[^,],%lu,%lu,%lu,%lu,%lu,%lu,%lx", result->name, &calls, &statusReads, &dataReads,
+			&dataWrites, &commands, &busTime, &memory) != 8)
+		{
+			continue;
+		}
+		
+		result->calls = calls;
+		result->statusReads = statusReads;
+		result->dataReads = dataReads;
+		result->dataWrites = dataWrites;
+		result->commands = commands;
+		result->busTime = busTime;
+		result->memory = memory;
+		count++;
+	}
+	
+	fclose(csv);
+	
+	return count;
+}
+
+int main(int argc, char **argv)
+{
+	static Result results[BENCH_MAX], baseline[BENCH_MAX];
+	FILE *csv;
+	int16_t count, index, base, baseCount, worse;
+	
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: bench results.csv [baseline.csv]\n");
+		return 2;
+	}
+	
+	LCD.init();
+	
+	count = sizeof(benches) / sizeof(benches[0]);
+	
+	for (index = 0; index < count; index++)
+	{
+		runBench(&benches[index], &results[index]);
+	}
+	
+	csv = fopen(argv[1], "w");
+	
+	if (!csv)
+	{
+		fprintf(stderr, "bench: cannot write %s\n", argv[1]);
+		return 2;
+	}
+	
+	fprintf(csv, "name,calls,status_reads,data_reads,data_writes,commands,bus_us,memory\n");
+	
+	for (index = 0; index < count; index++)
+	{
+		fprintf(csv, "%s,%lu,%lu,%lu,%lu,%lu,%lu,%08lx\n", results[index].name, (unsigned long)results[index].calls,
+			(unsigned long)results[index].statusReads, (unsigned long)results[index].dataReads,
+			(unsigned long)results[index].dataWrites, (unsigned long)results[index].commands,
+			(unsigned long)results[index].busTime, (unsigned long)results[index].memory);
+	}
+	
+	fclose(csv);
+	
+	printf("%-16s %6s %8s %8s %8s %8s %10s\n", "name", "calls", "status", "reads", "writes", "commands", "bus us");
+	
+	for (index = 0; index < count; index++)
+	{
+		printf("%-16s %6lu %8lu %8lu %8lu %8lu %10lu\n", results[index].name, (unsigned long)results[index].calls,
+			(unsigned long)results[index].statusReads, (unsigned long)results[index].dataReads,
+			(unsigned long)results[index].dataWrites, (unsigned long)results[index].commands,
+			(unsigned long)results[index].busTime);
+	}
+	
+	if (panel.errors)
+	{
+		fprintf(stderr, "bench: %lu bus cycles the controller would not accept\n", (unsigned long)panel.errors);
+		return 1;
+	}
+	
+	if (argc < 3)
+	{
+		return 0;
+	}
+	
+	baseCount = readResults(argv[2], baseline);
+	
+	if (baseCount < 0)
+	{
+		fprintf(stderr, "bench: cannot read %s\n", argv[2]);
+		return 2;
+	}
+	
+	// a benchmark missing from the baseline is new, not a regression
+	worse = 0;
+	
+	for (index = 0; index < count; index++)
+	{
+		for (base = 0; base < baseCount; base++)
+		{
+			if (strcmp(results[index].name, baseline[base].name) == 0)
+			{
+				break;
+			}
+		}
+		
+		if (base == baseCount)
+		{
+			continue;
+		}
+		
+		if (busCycles(&results[index]) > busCycles(&baseline[base]))
+		{
+			printf("%s: %lu bus cycles, was %lu\n", results[index].name, (unsigned long)busCycles(&results[index]),
+				(unsigned long)busCycles(&baseline[base]));
+			worse++;
+		}
+		
+		if (results[index].memory != baseline[base].memory)
+		{
+			printf("%s: display ram differs from the baseline\n", results[index].name);
+			worse++;
+		}
+	}
+	
+	return worse ? 1 : 0;
+}
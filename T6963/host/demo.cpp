@@ -0,0 +1,62 @@
+/*
+	Draws a test screen with the T6963 library on the host emulator and saves it
+
+	Usage:
+		demo [screen.pbm]
+*/
+
+#include <stdio.h>
+
+#include "../T6963.h"
+#include "T6963_Emulator.h"
+
+int main(int argc, char **argv)
+{
+	T6963Emulator panel(SCREEN_WIDTH, SCREEN_HEIGHT, FONT_WIDTH);
+	const char *file;
+	uint8_t count;
+	
+	file = (argc > 1) ? argv[1] : "screen.pbm";
+	
+	LCD.init();
+	
+	LCD.moveTo(20, 13);
+	LCD.rect(98, 98, 3);
+	
+	for (count = 0; count < 46; count += 3)
+	{
+		LCD.moveTo(25 + count, 12 + count);
+		LCD.line(92 - 2 * count, 0);
+	}
+	
+	LCD.moveTo(180, 40);
+	LCD.fillCircle(24);
+	LCD.setColor(0);
+	LCD.fillArc(16, 30, 150);
+	LCD.setColor(1);
+	
+	LCD.textTo(22, 10);
+	LCD.text((char*)"T6963 host");
+	
+	LCD.loadBigDigits(0x80);
+	LCD.textTo(24, 12);
+	LCD.bigText((char*)"42");
+	
+	LCD.flush();
+	
+#ifdef GLCD_QUEUE
+	LCD.sync();
+#endif
+
+	if (!panel.savePbm(file))
+	{
+		fprintf(stderr, "demo: cannot write %s\n", file);
+		return 1;
+	}
+	
+	printf("%s: %lu status reads, %lu data reads, %lu data writes, %lu commands, %lu errors\n", file,
+		(unsigned long)panel.statusReads, (unsigned long)panel.dataReads, (unsigned long)panel.dataWrites,
+		(unsigned long)panel.commands, (unsigned long)panel.errors);
+		
+	return panel.errors ? 1 : 0;
+}
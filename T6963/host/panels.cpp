@@ -0,0 +1,160 @@
+/*
+	Checks the T6963 library on panels whose width is not a multiple of the font
+
+	The controller shows every column that starts on the screen, so the last
+	text and graphic column of such a panel is partly visible. Text written to
+	the start of each row and a pixel in each corner must show up on the
+	emulated screen where they were drawn and nowhere else.
+
+	Usage:
+		panels
+*/
+
+#include <stdio.h>
+
+#include "../T6963.h"
+#include "T6963_Emulator.h"
+
+
+//*************************************************************************************************
+//	Checks
+//*************************************************************************************************
+
+//-------------------------------------------------------------------------------------------------
+//
+// Count lit pixels outside a rectangle of the emulated screen
+//
+//	Input	*panel: the emulator
+//			width, height: size of its screen
+//			x0, y0, x1, y1: rectangle where pixels may be lit (x1, y1 exclusive)
+//
+//	Output	pixels lit outside the rectangle
+//
+//-------------------------------------------------------------------------------------------------
+
+static uint16_t strayPixels(T6963Emulator *panel, uint16_t width, uint16_t height, uint16_t x0, uint16_t y0,
+	uint16_t x1, uint16_t y1)
+{
+	uint16_t x, y, count;
+	
+	count = 0;
+	
+	for (y = 0; y < height; y++)
+	{
+		for (x = 0; x < width; x++)
+		{
+			if (panel->pixel(x, y) && (x < x0 || x >= x1 || y < y0 || y >= y1))
+			{
+				count++;
+			}
+		}
+	}
+	
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Send everything drawn so far to the emulator
+//
+//-------------------------------------------------------------------------------------------------
+
+template <class Panel>
+static void show(Panel *lcd)
+{
+	lcd->flush();
+	
+#ifdef GLCD_QUEUE
+	lcd->sync();
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//
+// Draw text at the start of every row and a pixel in every corner of one panel
+//
+//	Output	number of failed checks
+//
+//-------------------------------------------------------------------------------------------------
+
+template <uint8_t Width, uint8_t Height, uint8_t Font, uint8_t Memory>
+static uint8_t checkPanel(void)
+{
+	static T6963Panel<Width, Height, Font, Memory> lcd;
+	T6963Emulator panel(Width, Height, Font);
+	uint8_t failed, row, corner, x, y;
+	uint16_t stray;
+	
+	failed = 0;
+	lcd.init();
+	
+	for (row = 0; row < Height / 8; row++)
+	{
+		lcd.clearText();
+		lcd.textTo(0, row);
+		lcd.text((char*)"AB");
+		show(&lcd);
+		
+		stray = strayPixels(&panel, Width, Height, 0, row * 8, 2 * Font, row * 8 + 8);
+		
+		if (stray)
+		{
+			printf("%dx%d font %d: text on row %d lights %d pixels elsewhere\n", Width, Height, Font, row, stray);
+			failed++;
+		}
+	}
+	
+	lcd.clearText();
+	show(&lcd);
+	
+	for (corner = 0; corner < 4; corner++)
+	{
+		x = (corner & 0x01) ? Width - 1 : 0;
+		y = (corner & 0x02) ? Height - 1 : 0;
+		
+		lcd.clearGraph();
+		lcd.moveTo(x, y);
+		lcd.horizLine(1);
+		show(&lcd);
+		
+		stray = strayPixels(&panel, Width, Height, x, y, x + 1, y + 1);
+		
+		if (stray || !panel.pixel(x, y))
+		{
+			printf("%dx%d font %d: pixel %d, %d is not alone on the screen\n", Width, Height, Font, x, y);
+			failed++;
+		}
+	}
+	
+	show(&lcd);
+	
+	if (panel.errors)
+	{
+		printf("%dx%d font %d: %lu bus cycles the controller would not accept\n", Width, Height, Font,
+			(unsigned long)panel.errors);
+		failed++;
+	}
+	
+	return failed;
+}
+
+int main(void)
+{
+	uint8_t failed;
+	
+	failed = 0;
+	failed += checkPanel<128, 64, 6, 4>();
+	failed += checkPanel<128, 64, 5, 4>();
+	failed += checkPanel<160, 128, 6, 8>();
+	failed += checkPanel<240, 64, 7, 8>();
+	failed += checkPanel<240, 128, 8, 8>();
+	
+	if (failed)
+	{
+		return 1;
+	}
+	
+	printf("panels: all checks passed\n");
+	
+	return 0;
+}
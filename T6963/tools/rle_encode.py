@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+	Run length encoder for T6963::drawRlePgm()
+
+	Reads a 1bpp PBM image (P1 or P4) and writes a C array for program memory.
+	Pixels are packed FONT_WIDTH to a byte in display memory order (bit
+	FONT_WIDTH - 1 is the leftmost pixel), the right edge is padded with white.
+
+	Format:
+		byte 0		width in columns
+		byte 1		height in rows
+		then runs covering width * height bytes
+			0x00-0x7F	n + 1 literal bytes follow
+			0x80-0xFF	the next byte repeated (n & 0x7F) + 3 times
+
+	Usage:
+		rle_encode.py image.pbm [-n name] [-f font_width] > image.h
+"""
+
+import argparse
+import sys
+
+
+def read_pbm(path):
+	with open(path, "rb") as f:
+		data = f.read()
+
+	# header tokens, skipping comments
+	tokens = []
+	pos = 0
+	while len(tokens) < 3:
+		while data[pos:pos + 1].isspace():
+			pos += 1
+		if data[pos:pos + 1] == b"#":
+			while data[pos:pos + 1] not in (b"\n", b""):
+				pos += 1
+			continue
+		start = pos
+		while not data[pos:pos + 1].isspace():
+			pos += 1
+		tokens.append(data[start:pos])
+
+	magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+
+	if magic == b"P1":
+		bits = [int(c) for c in data[pos:].decode("ascii") if c in "01"]
+		return width, height, [bits[y * width:(y + 1) * width] for y in range(height)]
+
+	if magic == b"P4":
+		pos += 1
+		stride = (width + 7) // 8
+		rows = []
+		for y in range(height):
+			row = data[pos + y * stride:pos + (y + 1) * stride]
+			rows.append([(row[x // 8] >> (7 - x % 8)) & 1 for x in range(width)])
+		return width, height, rows
+
+	raise SystemExit("%s: not a 1bpp PBM image" % path)
+
+
+def pack(width, rows, font_width):
+	cols = (width + font_width - 1) // font_width
+	out = []
+	for row in rows:
+		row = row + [0] * (cols * font_width - width)
+		for col in range(cols):
+			byte = 0
+			for pixel in row[col * font_width:(col + 1) * font_width]:
+				byte = (byte << 1) | pixel
+			out.append(byte)
+	return cols, out
+
+
+def encode(data):
+	out = []
+	literal = []
+	pos = 0
+
+	def flush():
+		while literal:
+			chunk = literal[:128]
+			del literal[:128]
+			out.append(len(chunk) - 1)
+			out.extend(chunk)
+
+	while pos < len(data):
+		run = 1
+		while pos + run < len(data) and run < 130 and data[pos + run] == data[pos]:
+			run += 1
+
+		if run >= 3:
+			flush()
+			out.append(0x80 | (run - 3))
+			out.append(data[pos])
+			pos += run
+		else:
+			literal.append(data[pos])
+			pos += 1
+
+	flush()
+	return out
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Encode a PBM image for T6963::drawRlePgm()")
+	parser.add_argument("image", help="1bpp PBM image (P1 or P4)")
+	parser.add_argument("-n", "--name", default="image", help="C array name")
+	parser.add_argument("-f", "--font-width", type=int, default=6, help="pixels per column (FONT_WIDTH)")
+	args = parser.parse_args()
+
+	width, height, rows = read_pbm(args.image)
+	cols, data = pack(width, rows, args.font_width)
+
+	if cols > 255 or height > 255:
+		raise SystemExit("%s: image too large" % args.image)
+
+	encoded = [cols, height] + encode(data)
+
+	sys.stdout.write("// %s: %dx%d pixels, %d bytes raw, %d bytes encoded\n" % (args.image, width, height, len(data), len(encoded)))
+	sys.stdout.write("const uint8_t %s[] PROGMEM = {\n" % args.name)
+	for pos in range(0, len(encoded), 16):
+		sys.stdout.write("\t" + ", ".join("0x%02X" % b for b in encoded[pos:pos + 16]) + ",\n")
+	sys.stdout.write("};\n")
+
+
+if __name__ == "__main__":
+	main()